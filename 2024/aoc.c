@@ -0,0 +1,102 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+
+#include "common/day.h"
+#include "common/thread.h"
+
+////////////////////////////////////////////////////////////////
+// Advent of Code 2024                                        //
+// Solves any of the days, running them concurrently          //
+////////////////////////////////////////////////////////////////
+
+// A day to solve and where to store its answers
+typedef struct {
+    const aocDay * day;
+    char path[4096];
+    uint64_t answers[2];
+    double ms;
+    int err;
+} job;
+
+// Returns a monotonic timestamp in milliseconds
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+// Solves a single day of the list
+static void runJob(int i, void * arg) {
+    job * j = (job *) arg + i;
+
+    double start = now();
+    j->err = solveDay(j->day, j->path, j->answers);
+    j->ms = now() - start;
+}
+
+static void usage(const char * name) {
+    fprintf(stderr, "Usage: %s [-j threads] [-t threads] [-i dir] [DAY[:PATH]]...\n", name);
+    fprintf(stderr, "Solves the days given, or every day if none is given.\n");
+    fprintf(stderr, "-j sets how many days run at once, -t how many threads a day can split its work on\n");
+    fprintf(stderr, "The input of a day defaults to DIR/dayNN/dayNNinput.txt, DIR is . by default\n");
+    fprintf(stderr, "A PATH of - reads the standard input\n");
+    exit(1);
+}
+
+int main(int argc, char ** argv) {
+    int threads = hardwareThreads();
+    const char * dir = ".";
+
+    // Read the options before the list of days
+    int arg = 1;
+    for (; arg < argc && argv[arg][0] == '-'; arg++) {
+        if (arg + 1 >= argc) usage(argv[0]);
+
+        if (strcmp(argv[arg], "-j") == 0) threads = atoi(argv[++arg]);
+        else if (strcmp(argv[arg], "-t") == 0) setDayThreads(atoi(argv[++arg]));
+        else if (strcmp(argv[arg], "-i") == 0) dir = argv[++arg];
+        else usage(argv[0]);
+    }
+
+    // Without any day given, solve all of them
+    int n = arg < argc ? argc - arg : aocDayCount;
+    job * jobs = calloc(n, sizeof(job));
+
+    for (int i = 0; i < n; i++) {
+        int number = arg < argc ? atoi(argv[arg + i]) : i + 1;
+        if (number < 1 || number > aocDayCount) usage(argv[0]);
+
+        jobs[i].day = aocDays[number - 1];
+
+        // Use the path given after the day or the default one
+        const char * path = arg < argc ? strchr(argv[arg + i], ':') : NULL;
+        if (path != NULL) snprintf(jobs[i].path, sizeof(jobs[i].path), "%s", path + 1);
+        else snprintf(jobs[i].path, sizeof(jobs[i].path), "%s/day%02d/day%02dinput.txt", dir, number, number);
+    }
+
+    // Every day is independent, the whole run takes about as long as the slowest one
+    double start = now();
+    parallelFor(n, threads, runJob, jobs);
+    double total = now() - start;
+
+    // Print the answers in the order the days were given
+    int err = 0;
+    for (int i = 0; i < n; i++) {
+        const aocDay * day = jobs[i].day;
+        err |= jobs[i].err;
+
+        printf("Day %d (%.3f ms)\n", day->number, jobs[i].ms);
+        if (jobs[i].err) continue;
+
+        printf("Part 1: \n\t%s: %" PRIu64 "\n", day->labels[0], jobs[i].answers[0]);
+        printf("Part 2: \n\t%s: %" PRIu64 "\n", day->labels[1], jobs[i].answers[1]);
+    }
+
+    printf("Total: %.3f ms\n", total);
+
+    free(jobs);
+    return err;
+}
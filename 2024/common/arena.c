@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+
+// Every allocation keeps the alignment of max_align_t
+#define ALIGN(size) (((size) + sizeof(max_align_t) - 1) & ~(sizeof(max_align_t) - 1))
+
+// Allocates a new block that can hold at least size bytes
+static arenaBlock * newBlock(size_t blockSize, size_t size) {
+    if (size < blockSize) size = blockSize;
+
+    arenaBlock * block = malloc(sizeof(arenaBlock) + size);
+    if (block == NULL) {
+        perror("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+void * arenaAlloc(arena * a, size_t size) {
+    size = ALIGN(size);
+
+    if (a->cur == NULL) a->first = a->cur = newBlock(a->blockSize, size);
+
+    // Move to the next block when the current one is full, reusing the blocks
+    // that are big enough and putting a new one in front of the others
+    while (a->cur->size - a->cur->used < size) {
+        arenaBlock * next = a->cur->next;
+        if (next == NULL || next->size < size) {
+            arenaBlock * block = newBlock(a->blockSize, size);
+            block->next = next;
+            a->cur->next = block;
+            next = block;
+        }
+
+        a->cur = next;
+        a->cur->used = 0;
+    }
+
+    void * ptr = (char *) a->cur->data + a->cur->used;
+    a->cur->used += size;
+    return ptr;
+}
+
+void * arenaCalloc(arena * a, size_t n, size_t size) {
+    void * ptr = arenaAlloc(a, n * size);
+    memset(ptr, 0, n * size);
+    return ptr;
+}
+
+arenaMark arenaSave(arena * a) {
+    if (a->cur == NULL) return (arenaMark) { NULL, 0 };
+
+    return (arenaMark) { a->cur, a->cur->used };
+}
+
+void arenaRestore(arena * a, arenaMark mark) {
+    // A mark taken before the first allocation goes back to the start
+    if (mark.block == NULL) {
+        arenaReset(a);
+        return;
+    }
+
+    // The blocks after the mark are emptied when they are reached again
+    a->cur = mark.block;
+    a->cur->used = mark.used;
+}
+
+void arenaReset(arena * a) {
+    a->cur = a->first;
+    if (a->cur != NULL) a->cur->used = 0;
+}
+
+void arenaFree(arena * a) {
+    arenaBlock * block = a->first;
+    while (block != NULL) {
+        arenaBlock * next = block->next;
+        free(block);
+        block = next;
+    }
+
+    a->first = a->cur = NULL;
+}
@@ -0,0 +1,54 @@
+#ifndef AOC_ARENA_H
+#define AOC_ARENA_H
+
+#include <stddef.h>
+
+////////////////////////////////////////////////////////////////
+// Advent of Code 2024 - Arena allocator                      //
+////////////////////////////////////////////////////////////////
+
+// Block of memory the allocations are carved from
+typedef struct arenaBlock {
+    struct arenaBlock * next;
+    size_t size; // Bytes available in data
+    size_t used; // Bytes already handed out
+    max_align_t data[];
+} arenaBlock;
+
+// Allocator that hands out memory by bumping an offset in big blocks.
+// Nothing is freed one at a time: the memory allocated after a mark is given
+// back at once, and the blocks are kept to be reused by the next allocations
+typedef struct {
+    arenaBlock * first;
+    arenaBlock * cur;   // Block the allocations are taken from
+    size_t blockSize;   // Size of the blocks allocated when more memory is needed
+} arena;
+
+// Position of an arena that it can go back to
+typedef struct {
+    arenaBlock * block;
+    size_t used;
+} arenaMark;
+
+// An empty arena that allocates blocks of the given size
+#define ARENA(blockSize) ((arena) { NULL, NULL, blockSize })
+
+// Returns size bytes aligned for any type, the memory isn't initialized
+void * arenaAlloc(arena * a, size_t size);
+
+// Returns memory for n elements of the given size set to zero
+void * arenaCalloc(arena * a, size_t n, size_t size);
+
+// Returns the current position of the arena
+arenaMark arenaSave(arena * a);
+
+// Gives back everything allocated since the mark was saved
+void arenaRestore(arena * a, arenaMark mark);
+
+// Gives back everything allocated, the blocks are kept
+void arenaReset(arena * a);
+
+// Frees every block of the arena
+void arenaFree(arena * a);
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef AOC_CHECKED_H
+#define AOC_CHECKED_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+////////////////////////////////////////////////////////////////
+// Advent of Code 2024 - Checked arithmetic                   //
+////////////////////////////////////////////////////////////////
+
+// The accumulators of the answers are updated through these macros. They are plain
+// operations by default, a build with -DAOC_CHECKED stops with an error as soon as one
+// of them overflows instead of printing a wrong answer
+#ifdef AOC_CHECKED
+
+// Reports where the overflow happened and stops the program
+static inline void overflowed(const char * file, int line) {
+    fprintf(stderr, "Overflow at %s:%d\n", file, line);
+    exit(EXIT_FAILURE);
+}
+
+// acc += val
+#define CHECKED_ADD(acc, val) \
+    do { if (__builtin_add_overflow((acc), (val), &(acc))) overflowed(__FILE__, __LINE__); } while (0)
+
+// res = a * b
+#define CHECKED_MUL(res, a, b) \
+    do { if (__builtin_mul_overflow((a), (b), &(res))) overflowed(__FILE__, __LINE__); } while (0)
+
+#else
+
+#define CHECKED_ADD(acc, val) ((acc) += (val))
+#define CHECKED_MUL(res, a, b) ((res) = (a) * (b))
+
+#endif
+
+#endif
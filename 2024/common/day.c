@@ -0,0 +1,41 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "day.h"
+
+// Solves a day reading its input a chunk at a time
+static int streamDay(const aocDay * day, const char * path, uint64_t answers[2]) {
+    inputStream st;
+    if (streamOpen(&st, path)) return 1;
+
+    int err = day->stream(&st, answers);
+    if (err) fprintf(stderr, "Error while parsing %s\n", path);
+
+    streamClose(&st);
+    return err;
+}
+
+int solveDay(const aocDay * day, const char * path, uint64_t answers[2]) {
+    // Piped inputs are streamed by the days that can solve them in a single pass
+    if (day->stream != NULL && strcmp(path, "-") == 0) return streamDay(day, path, answers);
+
+    // Map the file in memory
+    inputFile in;
+    if (inputOpen(&in, path)) return 1;
+
+    void * puzzle = day->parse(&in);
+    if (puzzle == NULL) {
+        fprintf(stderr, "Error while parsing %s\n", path);
+        inputClose(&in);
+        return 1;
+    }
+
+    answers[0] = day->part1(puzzle);
+    answers[1] = day->part2(puzzle);
+
+    // Free the puzzle before the input it might point to
+    day->release(puzzle);
+    inputClose(&in);
+
+    return 0;
+}
@@ -0,0 +1,44 @@
+#ifndef AOC_DAY_H
+#define AOC_DAY_H
+
+#include <stdint.h>
+
+#include "input.h"
+
+////////////////////////////////////////////////////////////////
+// Advent of Code 2024 - Common interface of every day        //
+////////////////////////////////////////////////////////////////
+
+// Describes how to solve a day. The input is parsed once in a puzzle that
+// both parts only read, so they can be timed and run again independently
+typedef struct {
+    int number;
+
+    // Description printed before the answer of each part
+    const char * labels[2];
+
+    // Builds the puzzle from the input, returns NULL on failure.
+    // The input stays mapped until the puzzle is released
+    void * (*parse)(const inputFile * in);
+
+    // Solve each part of the puzzle
+    uint64_t (*part1)(void * puzzle);
+    uint64_t (*part2)(void * puzzle);
+
+    // Frees the memory of the puzzle
+    void (*release)(void * puzzle);
+
+    // Optional, solves both parts in a single pass over a stream with constant memory.
+    // Used when the input is piped in, returns 0 on success
+    int (*stream)(inputStream * st, uint64_t answers[2]);
+} aocDay;
+
+// Every day of the year, the day n is at index n - 1
+extern const aocDay * const aocDays[];
+extern const int aocDayCount;
+
+// Solves a day on the input at path and stores the answers of both parts,
+// the path "-" reads the standard input. Returns 0 on success
+int solveDay(const aocDay * day, const char * path, uint64_t answers[2]);
+
+#endif
@@ -0,0 +1,10 @@
+#include "day.h"
+
+extern const aocDay day01, day02, day03, day04, day05, day06, day07, day08, day09, day10, day11;
+
+const aocDay * const aocDays[] = {
+    &day01, &day02, &day03, &day04, &day05, &day06,
+    &day07, &day08, &day09, &day10, &day11,
+};
+
+const int aocDayCount = sizeof(aocDays) / sizeof(aocDays[0]);
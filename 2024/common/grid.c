@@ -0,0 +1,35 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "grid.h"
+
+int gridMake(grid * g, int rows, int cols, int pad, char fill) {
+    int stride = cols + 2 * pad;
+    size_t size = (size_t) (rows + 2 * pad) * stride;
+
+    char * block = malloc(size);
+    if (block == NULL) return 1;
+    memset(block, fill, size);
+
+    *g = (grid) { block + (size_t) pad * stride + pad, block, rows, cols, pad, stride };
+    return 0;
+}
+
+int gridFromInput(grid * g, const inputFile * in, int pad, char fill) {
+    gridView view;
+    if (inputGrid(in, &view)) return 1;
+    if (gridMake(g, view.rows, view.cols, pad, fill)) return 1;
+
+    // Copy every line of the input in its row
+    for (int r = 0; r < view.rows; r++) {
+        memcpy(&GRID_AT(*g, r, 0), view.data + (size_t) r * view.stride, view.cols);
+    }
+
+    return 0;
+}
+
+void gridFree(grid * g) {
+    free(g->block);
+    *g = (grid) { NULL, NULL, 0, 0, 0, 0 };
+}
@@ -0,0 +1,42 @@
+#ifndef AOC_GRID_H
+#define AOC_GRID_H
+
+#include <stddef.h>
+
+#include "input.h"
+
+////////////////////////////////////////////////////////////////
+// Advent of Code 2024 - Padded grid                          //
+////////////////////////////////////////////////////////////////
+
+// Grid of characters stored in a single block, with a border of pad cells on every
+// side. A walk can step up to pad cells out of the grid and read the border instead
+// of checking the bounds, and moving in a direction is adding a fixed offset.
+// The cell (r, c) is at cells[r * stride + c], r and c can go from -pad to rows + pad - 1
+typedef struct {
+    char * cells;  // Address of the cell (0, 0)
+    char * block;  // Memory of the whole grid, border included
+    int rows;
+    int cols;
+    int pad;
+    int stride;    // cols + 2 * pad
+} grid;
+
+// The cell at row r and column c
+#define GRID_AT(g, r, c) ((g).cells[(ptrdiff_t) (r) * (g).stride + (c)])
+
+// Offset between a cell and its neighbour dr rows and dc columns away
+#define GRID_STEP(g, dr, dc) ((ptrdiff_t) (dr) * (g).stride + (dc))
+
+// Makes a grid of the given size with every cell, border included, set to fill.
+// Returns 0 on success
+int gridMake(grid * g, int rows, int cols, int pad, char fill);
+
+// Copies the grid of the input inside a border of pad cells set to fill.
+// Returns 0 on success
+int gridFromInput(grid * g, const inputFile * in, int pad, char fill);
+
+// Frees the memory of the grid
+void gridFree(grid * g);
+
+#endif
@@ -0,0 +1,53 @@
+#include <stdlib.h>
+
+#include "hash.h"
+
+// Allocates the slots of an empty table with the given capacity, a power of two
+static int makeSlots(hashTable * t, uint32_t cap) {
+    t->slots = malloc(cap * sizeof(hashSlot));
+    if (t->slots == NULL) return 1;
+
+    for (uint32_t i = 0; i < cap; i++) t->slots[i] = (hashSlot) { -1, t->empty };
+    t->mask = cap - 1;
+    t->used = 0;
+
+    return 0;
+}
+
+int hashInit(hashTable * t, uint32_t cap, int empty) {
+    // Keep the table at most half full
+    uint32_t size = 2;
+    while (size < 2 * cap) size *= 2;
+
+    t->empty = empty;
+    return makeSlots(t, size);
+}
+
+int * hashAdd(hashTable * t, int key) {
+    hashSlot * s = hashFind(t, key);
+    if (s->key >= 0) return &s->value;
+
+    // Double the table before it gets more than half full, moving every key
+    if (2 * (t->used + 1) > t->mask + 1) {
+        hashTable bigger = *t;
+        if (makeSlots(&bigger, 2 * (t->mask + 1))) return NULL;
+
+        for (uint32_t i = 0; i <= t->mask; i++) {
+            if (t->slots[i].key >= 0) *hashFind(&bigger, t->slots[i].key) = t->slots[i];
+        }
+
+        bigger.used = t->used;
+        free(t->slots);
+        *t = bigger;
+        s = hashFind(t, key);
+    }
+
+    s->key = key;
+    t->used++;
+    return &s->value;
+}
+
+void hashFree(hashTable * t) {
+    free(t->slots);
+    t->slots = NULL;
+}
@@ -0,0 +1,51 @@
+#ifndef AOC_HASH_H
+#define AOC_HASH_H
+
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////
+// Advent of Code 2024 - Integer hash table                   //
+////////////////////////////////////////////////////////////////
+
+// Slot of a hash table, empty slots have a negative key
+typedef struct {
+    int key;
+    int value;
+} hashSlot;
+
+// Table from non negative int keys to int values, with open addressing and linear
+// probing. It doubles when it's half full so the probes stay short
+typedef struct {
+    hashSlot * slots;
+    uint32_t mask; // Capacity - 1, the capacity is a power of two
+    uint32_t used; // Number of keys stored
+    int empty;     // Value of the keys that aren't stored
+} hashTable;
+
+// Makes an empty table with room for at least cap keys before it grows, the keys that
+// aren't stored have the value empty. Returns 0 on success
+int hashInit(hashTable * t, uint32_t cap, int empty);
+
+// Returns the slot where the key is stored or where it would be added
+static inline hashSlot * hashFind(const hashTable * t, int key) {
+    // Fibonacci hashing spreads consecutive keys over the table
+    uint32_t i = ((uint32_t) key * 2654435769u) & t->mask;
+
+    while (t->slots[i].key >= 0 && t->slots[i].key != key) i = (i + 1) & t->mask;
+    return &t->slots[i];
+}
+
+// Returns the value of a key
+static inline int hashGet(const hashTable * t, int key) {
+    return hashFind(t, key)->value;
+}
+
+// Returns the address of the value of a key, adding the key with the empty value if it's
+// not there yet. The address is valid till the next key is added, NULL if the table
+// couldn't grow
+int * hashAdd(hashTable * t, int key);
+
+// Frees the memory of the table
+void hashFree(hashTable * t);
+
+#endif
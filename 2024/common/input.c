@@ -0,0 +1,389 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "input.h"
+
+// Reads the whole content of a file descriptor in a growing buffer, used when
+// the file can't be mapped
+static int readAll(int fd, inputFile * in) {
+    size_t cap = 1 << 16, size = 0;
+    char * buffer = malloc(cap);
+    if (buffer == NULL) return 1;
+
+    ssize_t n;
+    while ((n = read(fd, buffer + size, cap - size)) > 0) {
+        size += n;
+
+        // Double the buffer when it's full
+        if (size == cap) {
+            char * tmp = realloc(buffer, cap * 2);
+            if (tmp == NULL) { free(buffer); return 1; }
+            buffer = tmp;
+            cap *= 2;
+        }
+    }
+
+    if (n < 0) { free(buffer); return 1; }
+
+    *in = (inputFile) { buffer, size, 0 };
+    return 0;
+}
+
+int inputOpen(inputFile * in, const char * path) {
+    int fd = strcmp(path, "-") == 0 ? dup(STDIN_FILENO) : open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error while opening file %s\n", path);
+        return 1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        // Map the whole file at once, the pages are loaded lazily by the kernel
+        void * data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            // The input is always read front to back
+            madvise(data, st.st_size, MADV_SEQUENTIAL);
+            *in = (inputFile) { data, st.st_size, 1 };
+            close(fd);
+            return 0;
+        }
+    }
+
+    // Empty files and anything that can't be mapped are read in memory
+    int err = readAll(fd, in);
+    close(fd);
+
+    if (err) fprintf(stderr, "Error while reading file\n");
+    return err;
+}
+
+void inputClose(inputFile * in) {
+    if (in->mapped) munmap((void *) in->data, in->size);
+    else free((void *) in->data);
+
+    *in = (inputFile) { NULL, 0, 0 };
+}
+
+int streamOpen(inputStream * st, const char * path) {
+    int fd = strcmp(path, "-") == 0 ? dup(STDIN_FILENO) : open(path, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error while opening file %s\n", path);
+        return 1;
+    }
+
+    char * buffer = malloc(STREAM_CHUNK);
+    if (buffer == NULL) { close(fd); return 1; }
+
+    *st = (inputStream) { fd, buffer, STREAM_CHUNK, 0, { buffer, buffer } };
+    return 0;
+}
+
+int streamRead(inputStream * st) {
+    if (st->eof) return 0;
+
+    // Keep the bytes not consumed yet at the start of the buffer
+    size_t kept = st->s.end - st->s.pos;
+    memmove(st->buffer, st->s.pos, kept);
+
+    // The buffer only grows if a single chunk isn't enough to hold what's left
+    if (kept == st->cap) {
+        char * tmp = realloc(st->buffer, st->cap * 2);
+        if (tmp == NULL) { st->eof = 1; return 0; }
+        st->buffer = tmp;
+        st->cap *= 2;
+    }
+
+    ssize_t n;
+    do n = read(st->fd, st->buffer + kept, st->cap - kept);
+    while (n < 0 && errno == EINTR);
+
+    if (n < 0) fprintf(stderr, "Error while reading file\n");
+    if (n <= 0) st->eof = 1;
+
+    st->s = (scanner) { st->buffer, st->buffer + kept + (n > 0 ? n : 0) };
+    return n > 0;
+}
+
+int streamLine(inputStream * st, lineView * ln) {
+    // Read chunks till the line is complete or the input is over
+    while (!st->eof && memchr(st->s.pos, '\n', st->s.end - st->s.pos) == NULL) streamRead(st);
+
+    return nextLine(&st->s, ln);
+}
+
+void streamClose(inputStream * st) {
+    close(st->fd);
+    free(st->buffer);
+    *st = (inputStream) { -1, NULL, 0, 1, { NULL, NULL } };
+}
+
+scanner inputScanner(const inputFile * in) {
+    return (scanner) { in->data, in->data + in->size };
+}
+
+scanner lineScanner(lineView ln) {
+    return (scanner) { ln.ptr, ln.ptr + ln.len };
+}
+
+void splitLines(scanner s, int parts, scanner * chunks) {
+    size_t size = s.end - s.pos;
+    const char * start = s.pos;
+
+    for (int i = 0; i < parts; i++) {
+        const char * end = s.end;
+
+        // Move the end of the chunk after the next newline
+        if (i < parts - 1) {
+            end = s.pos + size * (i + 1) / parts;
+            if (end < start) end = start;
+
+            const char * nl = memchr(end, '\n', s.end - end);
+            end = nl != NULL ? nl + 1 : s.end;
+        }
+
+        chunks[i] = (scanner) { start, end };
+        start = end;
+    }
+}
+
+int nextLine(scanner * s, lineView * ln) {
+    if (s->pos >= s->end) return 0;
+
+    // Find the end of the line, the last line might not have a newline
+    const char * nl = memchr(s->pos, '\n', s->end - s->pos);
+    if (nl == NULL) nl = s->end;
+
+    *ln = (lineView) { s->pos, nl - s->pos };
+
+    // Ignore the carriage return of files with windows line endings
+    if (ln->len > 0 && ln->ptr[ln->len - 1] == '\r') ln->len--;
+
+    s->pos = nl < s->end ? nl + 1 : nl;
+    return 1;
+}
+
+// The integers are found and converted with vector instructions when they are available:
+// a whole block of bytes is compared against '0' and '9' at once to find where the
+// digit runs start and end, then up to 8 digits are converted with a few multiplications
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BLOCK 32
+
+// Returns a mask with a bit set for every digit in the 32 bytes at p
+static inline uint32_t digitMask(const char * p) {
+    __m256i v = _mm256_loadu_si256((const __m256i *) p);
+    __m256i ge = _mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1));
+    __m256i le = _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), v);
+    return _mm256_movemask_epi8(_mm256_and_si256(ge, le));
+}
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define BLOCK 16
+
+// Returns a mask with a bit set for every digit in the 16 bytes at p
+static inline uint32_t digitMask(const char * p) {
+    __m128i v = _mm_loadu_si128((const __m128i *) p);
+    __m128i ge = _mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1));
+    __m128i le = _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1));
+    return _mm_movemask_epi8(_mm_and_si128(ge, le));
+}
+#endif
+
+#if defined(__AVX2__)
+// Returns a mask with a bit set for every byte equal to a or b in the 32 bytes at p
+static inline uint32_t eitherMask(const char * p, char a, char b) {
+    __m256i v = _mm256_loadu_si256((const __m256i *) p);
+    __m256i eq = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(a)), _mm256_cmpeq_epi8(v, _mm256_set1_epi8(b)));
+    return _mm256_movemask_epi8(eq);
+}
+#elif defined(__SSE2__)
+// Returns a mask with a bit set for every byte equal to a or b in the 16 bytes at p
+static inline uint32_t eitherMask(const char * p, char a, char b) {
+    __m128i v = _mm_loadu_si128((const __m128i *) p);
+    __m128i eq = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(a)), _mm_cmpeq_epi8(v, _mm_set1_epi8(b)));
+    return _mm_movemask_epi8(eq);
+}
+#endif
+
+#define IS_DIGIT(ch) ((unsigned) ((ch) - '0') <= 9)
+
+// Most digits of an integer that always fit in an int64_t
+#define MAX_DIGITS 18
+
+// Returns the address of the first digit in [p, end), or end if there are none
+static inline const char * skipToDigit(const char * p, const char * end) {
+#ifdef BLOCK
+    for (; p + BLOCK <= end; p += BLOCK) {
+        uint32_t mask = digitMask(p);
+        if (mask) return p + __builtin_ctz(mask);
+    }
+#endif
+
+    while (p < end && !IS_DIGIT(*p)) p++;
+    return p;
+}
+
+// Returns the number of consecutive digits starting at p
+static inline size_t digitRun(const char * p, const char * end) {
+    const char * q = p;
+
+#ifdef BLOCK
+    for (; q + BLOCK <= end; q += BLOCK) {
+        // Look for the first byte that isn't a digit
+        uint32_t mask = ~digitMask(q);
+#if BLOCK < 32
+        mask &= (1u << BLOCK) - 1;
+#endif
+        if (mask) return q - p + __builtin_ctz(mask);
+    }
+#endif
+
+    while (q < end && IS_DIGIT(*q)) q++;
+    return q - p;
+}
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+// Converts len (1 to 8) digits at p, reading 8 bytes.
+// The digits are moved to the top of the word so the bytes after them are dropped
+// and the missing leading digits become zeros, then pairs, quads and octets of digits
+// are combined with a multiplication each
+static inline uint64_t parseEight(const char * p, size_t len) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    v <<= 8 * (8 - len);
+
+    v = ((v & 0x0F0F0F0F0F0F0F0Full) * 2561) >> 8;
+    v = ((v & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+    return ((v & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32;
+}
+#endif
+
+// Converts the len digits at p to an integer. Only the last MAX_DIGITS digits
+// are kept, so a longer run can't overflow
+static inline int64_t digitsValue(const char * p, size_t len, const char * end) {
+    if (len > MAX_DIGITS) {
+        p += len - MAX_DIGITS;
+        len = MAX_DIGITS;
+    }
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (len <= 8 && p + 8 <= end) return parseEight(p, len);
+    if (len <= 16 && p + 16 <= end) return parseEight(p, len - 8) * 100000000 + parseEight(p + len - 8, 8);
+#endif
+
+    // Build the integer from left to right
+    uint64_t tmp = 0;
+    for (size_t i = 0; i < len; i++) tmp = tmp * 10 + (p[i] - '0');
+    return tmp;
+}
+
+const char * findEither(const char * p, const char * end, char a, char b) {
+#ifdef BLOCK
+    for (; p + BLOCK <= end; p += BLOCK) {
+        uint32_t mask = eitherMask(p, a, b);
+        if (mask) return p + __builtin_ctz(mask);
+    }
+#endif
+
+    while (p < end && *p != a && *p != b) p++;
+    return p;
+}
+
+int nextInt(scanner * s, int64_t * val) {
+    const char * p = s->pos;
+    size_t len = 0;
+
+#ifdef BLOCK
+    // Most integers are short, so a single block usually holds both
+    // the start and the end of the next one
+    for (; p + BLOCK <= s->end; p += BLOCK) {
+        uint32_t mask = digitMask(p);
+        if (mask == 0) continue;
+
+        int start = __builtin_ctz(mask);
+        uint64_t rest = ~((uint64_t) mask >> start);
+        p += start;
+        len = __builtin_ctzll(rest);
+
+        // The digits might go on in the next block
+        if ((int) len == BLOCK - start) len = digitRun(p, s->end);
+        break;
+    }
+#endif
+
+    // Skip everything that isn't a digit
+    if (len == 0) {
+        p = skipToDigit(p, s->end);
+        if (p == s->end) {
+            s->pos = p;
+            return 0;
+        }
+        len = digitRun(p, s->end);
+    }
+
+    *val = digitsValue(p, len, s->end);
+    s->pos = p + len;
+    return 1;
+}
+
+size_t scanInts(scanner * s, int64_t * out, size_t cap) {
+    size_t n = 0;
+
+#ifdef BLOCK
+    // Every integer starting in a block is found from the same mask, so the
+    // conversions don't wait on each other
+    const char * p = s->pos;
+    while (n < cap && p + BLOCK <= s->end) {
+        uint32_t mask = digitMask(p);
+        uint32_t starts = mask & ~(mask << 1);
+        const char * next = p + BLOCK;
+
+        for (; starts && n < cap; starts &= starts - 1) {
+            int start = __builtin_ctz(starts);
+            size_t len = __builtin_ctzll(~((uint64_t) mask >> start));
+
+            // The last integer might go on in the next block
+            if (start + len == BLOCK) len = digitRun(p + start, s->end);
+
+            out[n++] = digitsValue(p + start, len, s->end);
+            next = p + start + len;
+            if (next > p + BLOCK) break;
+        }
+
+        if (starts == 0 && next < p + BLOCK) next = p + BLOCK;
+        p = next;
+    }
+    s->pos = p;
+#endif
+
+    // Finish with the bytes that don't fill a block
+    while (n < cap && nextInt(s, &out[n])) n++;
+
+    return n;
+}
+
+int inputGrid(const inputFile * in, gridView * grid) {
+    // Ignore the line endings and the empty lines at the end of the input
+    size_t size = in->size;
+    while (size > 0 && (in->data[size - 1] == '\n' || in->data[size - 1] == '\r')) size--;
+
+    // The width of the grid is the length of the first line, the stride includes its line ending
+    const char * nl = memchr(in->data, '\n', size);
+    int cols = nl == NULL ? (int) size : (int) (nl - in->data);
+    int stride = cols + 1;
+    if (cols > 0 && in->data[cols - 1] == '\r') { cols--; }
+
+    // Every row but the last one is followed by a line ending, rounding up
+    // counts the last row whether its line ending was there or not
+    int rows = 0;
+    if (cols > 0) rows = (size + stride - 1) / stride;
+
+    *grid = (gridView) { in->data, rows, cols, stride };
+    return rows > 0 ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+#ifndef AOC_INPUT_H
+#define AOC_INPUT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////
+// Advent of Code 2024 - Shared input loader                  //
+// Maps an input file once and hands out zero-copy views      //
+////////////////////////////////////////////////////////////////
+
+// Whole input file, either memory mapped or read into a buffer
+typedef struct {
+    const char * data;
+    size_t size;
+    int mapped; // 1 if data must be released with munmap, 0 if with free
+} inputFile;
+
+// Cursor over a range of bytes of the input
+typedef struct {
+    const char * pos;
+    const char * end;
+} scanner;
+
+// A single line of the input, without the trailing newline
+typedef struct {
+    const char * ptr;
+    size_t len;
+} lineView;
+
+// A rectangular grid of characters laid out inside the input.
+// The cell (r, c) is at data[r * stride + c]
+typedef struct {
+    const char * data;
+    int rows;
+    int cols;
+    int stride;
+} gridView;
+
+// Input read a chunk at a time from a file or a pipe, only the bytes not
+// consumed yet are kept so the memory used doesn't depend on the input size
+typedef struct {
+    int fd;
+    char * buffer;
+    size_t cap;
+    int eof;
+    scanner s; // Bytes read but not consumed yet
+} inputStream;
+
+// Size of the chunks read by a stream
+#define STREAM_CHUNK (1 << 16)
+
+// Opens and maps the file at path, or reads the whole standard input if path is "-".
+// Returns 0 on success
+int inputOpen(inputFile * in, const char * path);
+
+// Releases the memory of an input opened with inputOpen
+void inputClose(inputFile * in);
+
+// Returns a scanner over the whole input
+scanner inputScanner(const inputFile * in);
+
+// Returns a scanner over a single line
+scanner lineScanner(lineView ln);
+
+// Splits the bytes of a scanner in parts chunks of about the same size, so they can be
+// processed in parallel. Every chunk but the last one ends right after a newline, some
+// might be empty
+void splitLines(scanner s, int parts, scanner * chunks);
+
+// Reads the next line, returns 0 when the end of the input is reached
+int nextLine(scanner * s, lineView * ln);
+
+// Reads the next unsigned integer skipping any non digit before it,
+// returns 0 when no more integers are found. A run of more than 18 digits
+// is read whole but its value is the one of its last 18 digits
+int nextInt(scanner * s, int64_t * val);
+
+// Reads up to cap unsigned integers in out like nextInt, returns the number of integers read
+size_t scanInts(scanner * s, int64_t * out, size_t cap);
+
+// Opens the file at path as a stream, or the standard input if path is "-".
+// Returns 0 on success
+int streamOpen(inputStream * st, const char * path);
+
+// Moves the bytes not consumed yet to the start of the buffer and reads the next
+// chunk after them, returns 0 when the end of the input is reached
+int streamRead(inputStream * st);
+
+// Reads the next whole line of the stream, returns 0 when the end of the input is reached.
+// The line is only valid till the next read of the stream
+int streamLine(inputStream * st, lineView * ln);
+
+// Closes a stream opened with streamOpen
+void streamClose(inputStream * st);
+
+// Returns the address of the first byte equal to a or b in [p, end), or end if there are none
+const char * findEither(const char * p, const char * end, char a, char b);
+
+// Describes the input as a grid using the length of the first line as width
+int inputGrid(const inputFile * in, gridView * grid);
+
+#endif
@@ -0,0 +1,278 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "search.h"
+
+// A word added to the dictionary, its letters are text[start] to text[start + len - 1]
+typedef struct {
+    int start;
+    int len;
+    int id;
+} searchWord;
+
+// A shape added to the dictionary, its letters are cells[first] to cells[first + count - 1]
+typedef struct {
+    int id;
+    int rows;
+    int cols;
+    int first;
+    int count;
+} searchShape;
+
+// A letter of a shape and its position from the top left corner of the shape
+typedef struct {
+    int dr;
+    int dc;
+    char ch;
+} searchCell;
+
+void searchInit(searchDict * d) {
+    memset(d, 0, sizeof(searchDict));
+    d->words = VECTOR(searchWord);
+    d->text = VECTOR(char);
+    d->shapes = VECTOR(searchShape);
+    d->cells = VECTOR(searchCell);
+}
+
+int searchAddWord(searchDict * d, const char * word) {
+    int len = strlen(word);
+    if (len == 0) return -1;
+
+    searchWord * w = vectorPush(&d->words);
+    *w = (searchWord) { d->text.len, len, d->patterns };
+
+    vectorReserve(&d->text, d->text.len + len);
+    memcpy((char *) d->text.data + d->text.len, word, len);
+    d->text.len += len;
+
+    return d->patterns++;
+}
+
+int searchAddShape(searchDict * d, const char * const * rows, int height) {
+    int width = height > 0 ? strlen(rows[0]) : 0;
+    size_t first = d->cells.len;
+
+    // Keep every letter that has to match, in the order of the rows
+    for (int r = 0; r < height; r++) {
+        if ((int) strlen(rows[r]) != width) { d->cells.len = first; return -1; }
+
+        for (int c = 0; c < width; c++) {
+            if (rows[r][c] == SEARCH_ANY) continue;
+            *(searchCell *) vectorPush(&d->cells) = (searchCell) { r, c, rows[r][c] };
+        }
+    }
+
+    if (d->cells.len == first) return -1;
+
+    searchShape * s = vectorPush(&d->shapes);
+    *s = (searchShape) { d->patterns, height, width, first, d->cells.len - first };
+
+    return d->patterns++;
+}
+
+// Adds a word to the trie reading its letters forward or backward, the trie is
+// kept in next where 0 means there is no child. Returns the node where the word ends
+static int trieInsert(searchDict * d, const char * word, int len, int backward) {
+    int node = 0;
+
+    for (int i = 0; i < len; i++) {
+        char ch = backward ? word[len - 1 - i] : word[i];
+        int32_t * child = &d->next[node * d->width + d->classes[(uint8_t) ch]];
+
+        if (*child == 0) *child = d->states++;
+        node = *child;
+    }
+
+    return node;
+}
+
+// Builds the Aho-Corasick automaton of the words, the words are added both ways
+// so reading a line forward also finds the words going the other way
+static void buildWords(searchDict * d) {
+    const char * text = d->text.data;
+
+    // Give an index only to the letters used, the others always go back to the root
+    d->width = 1;
+    for (size_t i = 0; i < d->text.len; i++) {
+        uint8_t ch = text[i];
+        if (d->classes[ch] == 0) d->classes[ch] = d->width++;
+    }
+
+    // Every letter of every word can add a node, plus the root
+    int nodes = 1 + 2 * d->text.len;
+    d->next = calloc((size_t) nodes * d->width, sizeof(int32_t));
+    d->states = 1;
+
+    // Remember where every word ends, a palindrome ends twice in the same node
+    // since it's found once per direction
+    int * ends = malloc(2 * d->words.len * sizeof(int));
+    d->longest = 0;
+    for (size_t i = 0; i < d->words.len; i++) {
+        searchWord w = VECTOR_AT(d->words, searchWord, i);
+        ends[2 * i] = trieInsert(d, text + w.start, w.len, 0);
+        ends[2 * i + 1] = trieInsert(d, text + w.start, w.len, 1);
+        if (w.len > d->longest) d->longest = w.len;
+    }
+
+    // Count the words ending in every node
+    int * own = calloc(d->states, sizeof(int));
+    for (size_t i = 0; i < 2 * d->words.len; i++) own[ends[i]]++;
+
+    // Visit the trie by levels so the failure link of a node, which is shorter,
+    // is always done before it. The missing children take the transition of the
+    // failure link, so the automaton never has to follow the links while counting
+    int * fail = calloc(d->states, sizeof(int));
+    int * queue = malloc(d->states * sizeof(int));
+    int * total = calloc(d->states, sizeof(int));
+    int head = 0, tail = 0;
+    queue[tail++] = 0;
+
+    while (head < tail) {
+        int u = queue[head++];
+        int32_t * row = &d->next[u * d->width];
+
+        // A node reports its own words and the ones of its failure link
+        total[u] = own[u] + (u ? total[fail[u]] : 0);
+
+        for (int a = 0; a < d->width; a++) {
+            int32_t failNext = u ? d->next[fail[u] * d->width + a] : 0;
+
+            if (row[a] == 0) {
+                row[a] = failNext;
+            } else {
+                fail[row[a]] = failNext;
+                queue[tail++] = row[a];
+            }
+        }
+    }
+
+    // Store the matches of every node one after the other
+    d->outStart = malloc((d->states + 1) * sizeof(int32_t));
+    d->outStart[0] = 0;
+    for (int u = 0; u < d->states; u++) d->outStart[u + 1] = d->outStart[u] + total[u];
+    d->out = malloc((d->outStart[d->states] + 1) * sizeof(searchMatch));
+
+    // Own words first, then the ones of the failure link which is already filled
+    int * filled = calloc(d->states, sizeof(int));
+    for (size_t i = 0; i < 2 * d->words.len; i++) {
+        searchWord w = VECTOR_AT(d->words, searchWord, i / 2);
+        int u = ends[i];
+        d->out[d->outStart[u] + filled[u]++] = (searchMatch) { w.id, w.len };
+    }
+
+    for (int i = 1; i < tail; i++) {
+        int u = queue[i];
+        memcpy(&d->out[d->outStart[u] + own[u]], &d->out[d->outStart[fail[u]]], total[fail[u]] * sizeof(searchMatch));
+    }
+
+    free(ends); free(own); free(fail); free(queue); free(total); free(filled);
+}
+
+void searchBuild(searchDict * d) {
+    buildWords(d);
+}
+
+// Adds to the counts the words reported by a state reading the line down to row r,
+// a word of length len starts in row r - len + 1 and is counted only if it's before the row end
+static inline void countMatches(const searchDict * d, int32_t state, int r, int end, uint64_t * counts) {
+    for (int i = d->outStart[state]; i < d->outStart[state + 1]; i++) {
+        if (r - d->out[i].len + 1 < end) counts[d->out[i].id]++;
+    }
+}
+
+// Counts the shapes whose top left corner is in row r, match has a byte for every column.
+// Every letter of a shape is compared for the whole row at once, without branches, so
+// the compiler can compare a vector of corners at a time
+static void countShapes(const searchDict * d, const grid * g, int r, uint8_t * match, uint64_t * counts) {
+    const searchCell * cells = d->cells.data;
+
+    for (size_t i = 0; i < d->shapes.len; i++) {
+        searchShape s = VECTOR_AT(d->shapes, searchShape, i);
+        if (r + s.rows > g->rows || s.cols > g->cols) continue;
+
+        // Number of corners where the shape fits in the row
+        int n = g->cols - s.cols + 1;
+        memset(match, 1, n);
+
+        for (int k = s.first; k < s.first + s.count; k++) {
+            const char * p = &GRID_AT(*g, r + cells[k].dr, cells[k].dc);
+            const char ch = cells[k].ch;
+
+            for (int c = 0; c < n; c++) match[c] &= p[c] == ch;
+        }
+
+        uint64_t total = 0;
+        for (int c = 0; c < n; c++) total += match[c];
+        counts[s.id] += total;
+    }
+}
+
+void searchCount(const searchDict * d, const grid * g, int r0, int r1, uint64_t * counts) {
+    const int32_t * next = d->next;
+    const int width = d->width;
+    const int cols = g->cols;
+
+    // Keep reading after the band till every word starting in it is complete,
+    // the shapes read the rows below their corner straight away
+    int end = r1 + d->longest - 1 < g->rows ? r1 + d->longest - 1 : g->rows;
+    if (end < r1) end = r1;
+
+    // State of the automaton reading every column, every diagonal going down right
+    // and every diagonal going down left, as they arrive at each column of the row
+    int32_t * down = calloc(3 * (size_t) cols, sizeof(int32_t));
+    int32_t * right = down + cols;
+    int32_t * left = right + cols;
+
+    uint8_t * match = malloc(cols + 1);
+
+    // Without words only the shapes are checked
+    const int words = d->words.len > 0;
+
+    for (int r = r0; r < end; r++) {
+        const char * row = &GRID_AT(*g, r, 0);
+
+        if (words) {
+            // The rows after the band only complete the lines going down
+            if (r < r1) {
+                int32_t state = 0;
+                for (int c = 0; c < cols; c++) {
+                    state = next[state * width + d->classes[(uint8_t) row[c]]];
+                    if (d->outStart[state] != d->outStart[state + 1]) countMatches(d, state, r, r1, counts);
+                }
+            }
+
+            // Every diagonal goes on from the row before, one column to the left or to the right.
+            // The columns are visited in the order that reads the previous state before it's overwritten
+            for (int c = cols - 1; c >= 0; c--) {
+                right[c] = next[(c ? right[c - 1] : 0) * width + d->classes[(uint8_t) row[c]]];
+            }
+            for (int c = 0; c < cols; c++) {
+                left[c] = next[(c + 1 < cols ? left[c + 1] : 0) * width + d->classes[(uint8_t) row[c]]];
+            }
+
+            for (int c = 0; c < cols; c++) {
+                down[c] = next[down[c] * width + d->classes[(uint8_t) row[c]]];
+
+                if (d->outStart[down[c]] != d->outStart[down[c] + 1]) countMatches(d, down[c], r, r1, counts);
+                if (d->outStart[right[c]] != d->outStart[right[c] + 1]) countMatches(d, right[c], r, r1, counts);
+                if (d->outStart[left[c]] != d->outStart[left[c] + 1]) countMatches(d, left[c], r, r1, counts);
+            }
+        }
+
+        if (r < r1) countShapes(d, g, r, match, counts);
+    }
+
+    free(down);
+    free(match);
+}
+
+void searchFree(searchDict * d) {
+    vectorFree(&d->words);
+    vectorFree(&d->text);
+    vectorFree(&d->shapes);
+    vectorFree(&d->cells);
+    free(d->next);
+    free(d->outStart);
+    free(d->out);
+}
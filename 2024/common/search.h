@@ -0,0 +1,66 @@
+#ifndef AOC_SEARCH_H
+#define AOC_SEARCH_H
+
+#include <stdint.h>
+
+#include "grid.h"
+#include "vector.h"
+
+////////////////////////////////////////////////////////////////
+// Advent of Code 2024 - Multi-pattern grid search            //
+////////////////////////////////////////////////////////////////
+
+// Character of a shape that matches any character of the grid
+#define SEARCH_ANY '.'
+
+// A word or shape reported by a state of the automaton
+typedef struct {
+    int id;
+    int len;
+} searchMatch;
+
+// Dictionary of words and shapes counted together over a grid.
+// The words are found in the 8 directions by an Aho-Corasick automaton that reads
+// every row, column and diagonal of the grid at once, the shapes are compared a whole
+// row of corners at a time. Every pattern gets an id, starting from 0
+typedef struct {
+    int patterns;      // Number of words and shapes added
+
+    // What was added, kept till the dictionary is built
+    vector words;      // Offset, length and id of every word in text
+    vector text;       // Letters of every word
+    vector shapes;     // Size, id and cells of every shape
+    vector cells;      // Letters of every shape with their position
+
+    // Automaton of the words, made by searchBuild
+    uint8_t classes[256]; // Index of every letter used by the words, 0 for the others
+    int width;            // Number of classes, letters used + 1
+    int states;
+    int32_t * next;       // The state after a state and a class, at next[state * width + class]
+    int32_t * outStart;   // The matches of a state are out[outStart[state]] to out[outStart[state + 1] - 1]
+    searchMatch * out;
+    int longest;          // Length of the longest word
+} searchDict;
+
+// Makes an empty dictionary
+void searchInit(searchDict * d);
+
+// Adds a word, found in any of the 8 directions, returns its id
+int searchAddWord(searchDict * d, const char * word);
+
+// Adds a shape given as rows of the same width, SEARCH_ANY matches any letter.
+// Returns its id, or -1 if the rows don't have the same width or every cell is SEARCH_ANY
+int searchAddShape(searchDict * d, const char * const * rows, int height);
+
+// Builds the automaton, must be called after the last word or shape is added
+void searchBuild(searchDict * d);
+
+// Adds to counts[id] the number of times every pattern starts in the rows [r0, r1) of the grid.
+// A word starts at its top letter, or its left one if it's horizontal, a shape at its top left
+// corner. The rows after r1 are read to find the words and shapes going down from the last rows
+void searchCount(const searchDict * d, const grid * g, int r0, int r1, uint64_t * counts);
+
+// Frees the memory of the dictionary
+void searchFree(searchDict * d);
+
+#endif
@@ -0,0 +1,65 @@
+#include <pthread.h>
+#include <unistd.h>
+
+#include "thread.h"
+
+// Work shared between the threads of the pool
+typedef struct {
+    int tasks;
+    int next; // Index of the next task to run, taken atomically
+    void (*task)(int i, void * arg);
+    void * arg;
+} pool;
+
+// Set once by the runner before any day starts
+static int threadsPerDay = 1;
+
+int dayThreads(void) {
+    return threadsPerDay;
+}
+
+void setDayThreads(int threads) {
+    threadsPerDay = threads > 0 ? threads : 1;
+}
+
+int chunksFor(size_t bytes) {
+    size_t parts = bytes / CHUNK_BYTES;
+    if (parts > (size_t) threadsPerDay) parts = threadsPerDay;
+
+    return parts > 0 ? (int) parts : 1;
+}
+
+int hardwareThreads(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? n : 1;
+}
+
+// Keeps taking tasks till there are none left
+static void * worker(void * arg) {
+    pool * p = arg;
+    int i;
+
+    while ((i = __atomic_fetch_add(&p->next, 1, __ATOMIC_RELAXED)) < p->tasks) {
+        p->task(i, p->arg);
+    }
+
+    return NULL;
+}
+
+void parallelFor(int tasks, int threads, void (*task)(int i, void * arg), void * arg) {
+    pool p = { tasks, 0, task, arg };
+
+    if (threads > tasks) threads = tasks;
+    if (threads < 1) threads = 1;
+
+    // The calling thread is part of the pool
+    pthread_t ids[threads];
+    int started = 1;
+    for (; started < threads; started++) {
+        if (pthread_create(&ids[started], NULL, worker, &p) != 0) break;
+    }
+
+    worker(&p);
+
+    for (int i = 1; i < started; i++) pthread_join(ids[i], NULL);
+}
@@ -0,0 +1,29 @@
+#ifndef AOC_THREAD_H
+#define AOC_THREAD_H
+
+#include <stddef.h>
+
+////////////////////////////////////////////////////////////////
+// Advent of Code 2024 - Thread pool                          //
+////////////////////////////////////////////////////////////////
+
+// Returns the number of processors available
+int hardwareThreads(void);
+
+// Number of threads a single day can split its own work on, 1 unless set
+int dayThreads(void);
+void setDayThreads(int threads);
+
+// Smallest amount of input worth giving to a thread of its own
+#define CHUNK_BYTES (1 << 16)
+
+// Number of chunks to split a day's work on bytes of input in: one per thread the day
+// can use, as long as every chunk has at least CHUNK_BYTES, and at least one
+int chunksFor(size_t bytes);
+
+// Runs task(i, arg) for every i in [0, tasks) on a pool of threads.
+// Each thread picks the next task as soon as it's done with the previous one,
+// so slow tasks don't hold back the others. Returns when every task is done
+void parallelFor(int tasks, int threads, void (*task)(int i, void * arg), void * arg);
+
+#endif
@@ -0,0 +1,37 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "vector.h"
+
+void vectorReserve(vector * v, size_t n) {
+    if (n <= v->cap) return;
+
+    // Double the capacity till it's enough
+    size_t cap = v->cap ? v->cap : 16;
+    while (cap < n) cap *= 2;
+
+    void * data = realloc(v->data, cap * v->size);
+    if (data == NULL) {
+        perror("Memory allocation failed");
+        exit(EXIT_FAILURE);
+    }
+
+    v->data = data;
+    v->cap = cap;
+}
+
+void * vectorPush(vector * v) {
+    if (v->len == v->cap) vectorReserve(v, v->len + 1);
+
+    return (char *) v->data + v->len++ * v->size;
+}
+
+void vectorClear(vector * v) {
+    v->len = 0;
+}
+
+void vectorFree(vector * v) {
+    free(v->data);
+    v->data = NULL;
+    v->len = v->cap = 0;
+}
@@ -0,0 +1,37 @@
+#ifndef AOC_VECTOR_H
+#define AOC_VECTOR_H
+
+#include <stddef.h>
+
+////////////////////////////////////////////////////////////////
+// Advent of Code 2024 - Growable array                       //
+////////////////////////////////////////////////////////////////
+
+// Array that doubles its capacity when it's full, so adding an element
+// costs O(1) amortised instead of a realloc every time
+typedef struct {
+    void * data;
+    size_t len;  // Number of elements stored
+    size_t cap;  // Number of elements that fit before growing
+    size_t size; // Size of each element in bytes
+} vector;
+
+// An empty vector of elements of the given type
+#define VECTOR(type) ((vector) { NULL, 0, 0, sizeof(type) })
+
+// The i-th element of a vector of the given type
+#define VECTOR_AT(v, type, i) (((type *) (v).data)[i])
+
+// Makes room for at least n elements
+void vectorReserve(vector * v, size_t n);
+
+// Adds an element at the end and returns its address, the element isn't initialized
+void * vectorPush(vector * v);
+
+// Removes every element but keeps the memory to be reused
+void vectorClear(vector * v);
+
+// Frees the memory of the vector
+void vectorFree(vector * v);
+
+#endif
@@ -1,137 +1,192 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "../common/day.h"
+#include "../common/checked.h"
+#include "../common/hash.h"
+#include "../common/vector.h"
 
 ////////////////////////////////////////////////////////////////
 // Advent of Code 2024 Day 1                                  //
 // Link: https://adventofcode.com/2024/day/1                  //
 ////////////////////////////////////////////////////////////////
 
-#define filename "day01input.txt"
+// The two lists of location IDs
+typedef struct {
+    vector a;
+    vector b;
+} lists;
 
-// Reads two arrays from a file and returns the number of elements in the arrays
-int readArrays(int ** arrA, int ** arrB) {
-    // Opens the file in read mode
-    FILE * fp = fopen(filename, "r");
-    if (fp == NULL) {
-        printf("Error while opening file\n");
-        return 1;
-    }   
-
-    // Initialize the number of elements and the variables to store 
-    //the two integers on each line of the file
-    int n = 0;
-    int a, b;
+// Reads two arrays from the input into the vectors
+static void readArrays(const inputFile * in, vector * arrA, vector * arrB) {
+    // The numbers are read in batches, alternating between the two lists
+    int64_t batch[512];
+    size_t n;
 
     // Read all the numbers from the file till the end
-    while (fscanf(fp, "%d %d", &a, &b) == 2) {
-        // Increment the number of elements in the arrays
-        n++;
-
-        // Reallocate the arrays to have one more element
-        *arrA = (int *)realloc(*arrA, n * sizeof(int));
-        *arrB = (int *)realloc(*arrB, n * sizeof(int));
-
-        // Add the new values on that line to the arrays
-        (*arrA)[n - 1] = a;
-        (*arrB)[n - 1] = b;
+    scanner s = inputScanner(in);
+    while ((n = scanInts(&s, batch, 512)) >= 2) {
+        // Make room for the whole batch then add the new values of every line to the arrays
+        vectorReserve(arrA, arrA->len + n / 2);
+        vectorReserve(arrB, arrB->len + n / 2);
+        int * a = (int *) arrA->data + arrA->len;
+        int * b = (int *) arrB->data + arrB->len;
+
+        for (size_t i = 0; i + 1 < n; i += 2) {
+            a[i / 2] = batch[i];
+            b[i / 2] = batch[i + 1];
+        }
+        arrA->len += n / 2;
+        arrB->len += n / 2;
     }
-
-    // Return the number of elements in the arrays
-    return n;
 }
 
 
 
-// Swaps the pointers to two integers
-void swap(int *a, int *b) {
-    int temp = *a;
-    *a = *b;
-    *b = temp;
-}
-
 // Returns the distance between two arrays
-int distance(int *a, int *b, int n) {
-    int d = 0;
+// The loop has no branches so the compiler can vectorize it, and the sum is kept on
+// 64 bits since millions of pairs easily overflow an int
+static uint64_t distance(const int * restrict a, const int * restrict b, int n) {
+    uint64_t d = 0;
     for (int i = 0; i < n; i++) {
         // Adds the distance between the two elements of the same index in the two arrays
-        d += abs(a[i] - b[i]);
+        int diff = a[i] - b[i];
+        CHECKED_ADD(d, (uint32_t) (diff < 0 ? -diff : diff));
     }
     return d;
 }
 
-// Sorts an array using the bubble sort algorithm
-void bubblesort(int *arr, int n) {
-    for (int i = 0; i < n - 1; i++) {
-        for (int j = 0; j < n - i - 1; j++) {
-            // If the current element is greater than the next one, swap them
-            if (arr[j] > arr[j + 1]) {
-                swap(&arr[j], &arr[j + 1]);
-            }
-        }
+// Sorts an array of integers in [min, max] by counting the occurrences of each value
+static void countingsort(int *arr, int n, int min, int max) {
+    int *counts = calloc((size_t) max - min + 1, sizeof(int));
+
+    for (int i = 0; i < n; i++) counts[arr[i] - min]++;
+
+    // Write every value back as many times as it appeared
+    int k = 0;
+    for (int v = 0; v <= max - min; v++) {
+        for (int c = counts[v]; c > 0; c--) arr[k++] = v + min;
     }
+
+    free(counts);
 }
 
-// Returns the number of occurrences of a target value in an array
-int countOccurrences(int *arr, int n, int target) {
-    // Initialize a counter to keep track of the number of occurrences
-    int count = 0;
+// Sorts an array of non negative integers using a least significant digit radix sort
+// with two 16 bit digits
+static void radixsort(int *arr, int n) {
+    if (n < 2) return;
 
-    // Loop through each element in the array
-    for (int i = 0; i < n; i++) {
-        // If the current element is equal to the target value
-        if (arr[i] == target) {
-            // Increment the counter
-            count++;
-        }
+    int min = arr[0], max = arr[0];
+    for (int i = 1; i < n; i++) {
+        if (arr[i] < min) min = arr[i];
+        if (arr[i] > max) max = arr[i];
+    }
+
+    // When the values are close to each other counting them is a single pass
+    if ((int64_t) max - min <= 65535 || (int64_t) max - min <= n) {
+        countingsort(arr, n, min, max);
+        return;
+    }
+
+    int *tmp = malloc(n * sizeof(int));
+    int *src = arr, *dst = tmp;
+
+    // The counts are too big for the stack of a worker thread, both passes share them
+    int *counts = malloc((65536 + 1) * sizeof(int));
+
+    // Sort by the low digit first then by the high one, each pass is stable
+    for (int shift = 0; shift < 32; shift += 16) {
+        memset(counts, 0, (65536 + 1) * sizeof(int));
+
+        for (int i = 0; i < n; i++) counts[(((uint32_t) src[i] >> shift) & 0xFFFF) + 1]++;
+
+        // Turn the counts in the position where each digit starts
+        for (int d = 0; d < 65536; d++) counts[d + 1] += counts[d];
+
+        for (int i = 0; i < n; i++) dst[counts[((uint32_t) src[i] >> shift) & 0xFFFF]++] = src[i];
+
+        int *swap = src; src = dst; dst = swap;
     }
 
-    // Return the number of occurrences
-    return count;
+    // After an even number of passes the sorted values are back in arr
+    free(tmp);
+    free(counts);
 }
 
-// Returns an array with the product between each element of a and the number of occurrences of that element in b
-int * arrProduct(int *a, int *b, int n) {
-    // Allocate memory for the new array
-    int * c = (int *)malloc(n * sizeof(int));
+// Counts the occurrences of every value of the array in a single pass
+static int countFrequencies(hashTable * f, const int *arr, int n) {
+    // The table grows with the number of distinct IDs, not with the length of the list,
+    // so it stays small enough to fit in the cache
+    if (hashInit(f, 512, 0)) return 1;
 
-    // For each element in a
     for (int i = 0; i < n; i++) {
-        // Multiply the element by the number of times it appears in b
-        c[i] = a[i] * countOccurrences(b, n, a[i]);
+        int * count = hashAdd(f, arr[i]);
+        if (count == NULL) return 1;
+        (*count)++;
     }
 
-    return c;
+    return 0;
 }
 
+// Returns the sum of the product between each element of a and the number of occurrences of that element in b
+static uint64_t similarity(const int *a, const int *b, int n) {
+    hashTable f;
+    if (countFrequencies(&f, b, n)) {
+        fprintf(stderr, "Memory allocation failed\n");
+        hashFree(&f);
+        return 0;
+    }
 
-// Returns the sum of the values in an array
-int arrSum(int *arr, int n) {
-    int sum = 0;
+    // Sum the products straight away without storing them
+    uint64_t sum = 0, product;
     for (int i = 0; i < n; i++) {
-        sum += arr[i];
+        CHECKED_MUL(product, (uint64_t) a[i], hashGet(&f, a[i]));
+        CHECKED_ADD(sum, product);
     }
+
+    hashFree(&f);
     return sum;
 }
 
-int main(void) {
-    int *a  = NULL, *b  = NULL, *c = NULL;
-    int n = readArrays(&a, &b);
+// Reads both lists from the input and sorts them, so the parts only read them
+static void * parseLists(const inputFile * in) {
+    lists * l = malloc(sizeof(lists));
+    l->a = VECTOR(int);
+    l->b = VECTOR(int);
+    readArrays(in, &l->a, &l->b);
 
-    // Sort the arrays
-    bubblesort(a, n);
-    bubblesort(b, n);
+    // Sort the arrays in linear time
+    radixsort(l->a.data, l->a.len);
+    radixsort(l->b.data, l->b.len);
+
+    return l;
+}
 
-    // Part 1: Print the distance between the two arrays
-    printf("Part 1: \n\tDistance between a and b is: %d\n", distance(a, b, n));
+// Part 1: Returns the distance between the sorted lists
+static uint64_t totalDistance(void * puzzle) {
+    lists * l = puzzle;
+    return distance(l->a.data, l->b.data, l->a.len);
+}
 
-    c = arrProduct(a, b, n);
+// Part 2: Returns the sum of the product between the two arrays
+static uint64_t similarityScore(void * puzzle) {
+    lists * l = puzzle;
+    return similarity(l->a.data, l->b.data, l->a.len);
+}
 
-    // Part 2: Print the sum of the product between the two arrays
-    printf("Part 2: \n\tSum of arrC is: %d\n", arrSum(c, n));
+// Free the memory of both lists
+static void freeLists(void * puzzle) {
+    lists * l = puzzle;
+    vectorFree(&l->a); vectorFree(&l->b);
+    free(l);
+}
 
-    // Free the memory and close the file
-    free(a); free(b); free(c);
-    
-    return 0;
-}
\ No newline at end of file
+const aocDay day01 = {
+    .number = 1,
+    .labels = { "Distance between a and b is", "Similarity score is" },
+    .parse = parseLists,
+    .part1 = totalDistance,
+    .part2 = similarityScore,
+    .release = freeLists,
+};
@@ -1,178 +1,219 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <ctype.h>
+
+#include "../common/day.h"
+#include "../common/vector.h"
+#include "../common/thread.h"
 
 ////////////////////////////////////////////////////////////////
 // Advent of Code 2024 Day 2                                  //
 // Link: https://adventofcode.com/2024/day/2                  //
 ////////////////////////////////////////////////////////////////
 
-#define filename "day02input.txt"
-
-// Reads a line from a file and returns the number of integers it contains
-int readLine(FILE *fp, int **arr) {
-    int tmp, n = 0;
-    char ch;
-
-    int *tempArr = NULL;
-
-    // Read till the end of the line or the end of the file
-    while ((ch = fgetc(fp)) != '\n' && ch != EOF) {
-        // Skip to the next character if it's not a digit
-        if (!isdigit(ch)) continue;
-
-        tmp = 0;
-
-        // Build the integer from left to right
-        do {
-            tmp = tmp * 10 + (ch - '0');
-            ch = fgetc(fp);
-        } while (isdigit(ch));
-
-        // Reallocate the array and add the new value
-        tempArr = (int *)realloc(tempArr, (n + 1) * sizeof(int));
-        if (tempArr == NULL) {
-            printf("Memory allocation failed\n");
-            free(tempArr);
-            return 0;
-        }
-
-        tempArr[n] = tmp;
+// Number of safe reports and of unsafe reports fixed by removing a level,
+// a stream answers both parts in the same pass over the reports
+typedef struct {
+    uint64_t safe;
+    uint64_t fixable;
+} reportCounts;
+
+// Reads a line from the input appending its integers to the vector,
+// returns the number of integers it contains
+static int readLine(scanner *s, vector *arr) {
+    int n = 0;
+    int64_t tmp;
+    lineView ln;
+
+    // Stop if the end of the input is reached
+    if (!nextLine(s, &ln)) return 0;
+
+    // Read every integer till the end of the line
+    scanner ls = lineScanner(ln);
+    while (nextInt(&ls, &tmp)) {
+        *(int *) vectorPush(arr) = tmp;
         n++;
-
-        // Break the loop if the end of the line is reached, necessary since the last character hasn't been read yet
-        if (ch == '\n') break;
     }
 
-    // Save the array on the pointer passed and return the number of elements
-    *arr = tempArr;
-
     return n;
 }
 
-// Checks if an array is increasing (strictly or not)
-int isIncreasing(int *arr, int n) {
-    for (int i = 0; i < n - 1; i++) {
-        if (arr[i] > arr[i + 1]) {
-            return 0;
-        }
-    }
-    return 1;
+// Checks if the step between two levels goes in the direction dir (1 up, -1 down)
+// by at least 1 and at most 3
+static inline int isGoodStep(int from, int to, int dir) {
+    int diff = (to - from) * dir;
+    return diff >= 1 && diff <= 3;
 }
 
-// Checks if an array is decreasing (strictly or not)
-int isDecreasing(int *arr, int n) {
-    for (int i = 0; i < n - 1; i++) {
-        if (arr[i] < arr[i + 1]) {
-            return 0;
-        }
+// Walks the differences between consecutive levels ignoring the level at index skip (-1 to keep all),
+// returns the index of the level before the first bad step or -1 if every step is good
+static int firstBadStep(const int *arr, int n, int dir, int skip) {
+    int prev = skip == 0 ? 1 : 0;
+
+    for (int i = prev + 1; i < n; i++) {
+        if (i == skip) continue;
+        if (!isGoodStep(arr[prev], arr[i], dir)) return prev;
+        prev = i;
     }
-    return 1;
+
+    return -1;
 }
 
-// Checks if an array is safe
-int isSafe(int *arr, int n) {
-    // Check if the array is either increasing or decreasing
-    if (!isIncreasing(arr, n) && !isDecreasing(arr, n)) {
-        return 0;    
-    }
+// Checks if an array is safe in a single pass, the first step tells if it must increase or decrease
+static int isSafe(const int *arr, int n) {
+    if (n < 2) return 1;
 
-    // Check if the distance between every element and the consequent is in the range [1, 3]
-    int tmp;
-    for (int i = 0; i < n - 1; i++) {
-        tmp = abs(arr[i] - arr[i + 1]);
-        if (tmp < 1 || tmp > 3) {
-            return 0;
-        }
+    int dir = arr[1] > arr[0] ? 1 : -1;
+    return firstBadStep(arr, n, dir, -1) < 0;
+}
+
+// Checks if removing a single level makes an array safe in O(n). The first bad step
+// of a direction must lose one of its two levels, so only those two are tried
+static int isFixable(const int *arr, int n) {
+    for (int dir = -1; dir <= 1; dir += 2) {
+        int k = firstBadStep(arr, n, dir, -1);
+        if (k < 0) return 1;
+
+        if (firstBadStep(arr, n, dir, k) < 0 || firstBadStep(arr, n, dir, k + 1) < 0) return 1;
     }
 
-    return 1;
+    return 0;
+}
+
+// Checks a single report for both parts
+static void checkReport(const int *levels, int n, reportCounts *counts) {
+    if (isSafe(levels, n)) counts->safe++;
+    else if (isFixable(levels, n)) counts->fixable++;
 }
 
-int countSafeReports(void) {
-    // Open the file
-    FILE * fp = fopen(filename, "r");
-    if (fp == NULL) {
-        printf("Error while opening file\n");
-        return 1;    
+// Reports read by a thread, the levels of the report i are levels[starts[i]]
+// to levels[starts[i + 1] - 1]
+typedef struct {
+    scanner s;
+    vector levels;
+    vector starts;
+} reportChunk;
+
+// The reports of the input, split in chunks at newlines
+typedef struct {
+    int parts;
+    reportChunk * chunks;
+} reportList;
+
+// Reads the reports of a chunk, lines without levels aren't reports
+static void readChunk(int i, void * arg) {
+    reportChunk * chunk = (reportChunk *) arg + i;
+
+    *(size_t *) vectorPush(&chunk->starts) = 0;
+    while (chunk->s.pos < chunk->s.end) {
+        if (readLine(&chunk->s, &chunk->levels) > 0) *(size_t *) vectorPush(&chunk->starts) = chunk->levels.len;
     }
+}
 
-    // Allocate memory for the array that will be read from the file
-    int * tmp;
-    int count = 0, n;
-
-    // Read the file line by line, stop when the end of the file is reached
-    while ((n = readLine(fp, &tmp)) > 0) {
+// Reads every report of the input. Every report is independent so the input is
+// split at newlines and the chunks are read in parallel, then checked the same way by the parts
+static void * parseReports(const inputFile * in) {
+    reportList * r = calloc(1, sizeof(reportList));
 
-        // Check if the line is safe
-        if (isSafe(tmp, n)) {
-            // If the line is safe, increment the count
-            count++;
-        }
+    r->parts = chunksFor(in->size);
+    r->chunks = calloc(r->parts, sizeof(reportChunk));
 
-        // Free the memory allocated for the array
-        free(tmp);
+    scanner s[r->parts];
+    splitLines(inputScanner(in), r->parts, s);
+    for (int i = 0; i < r->parts; i++) {
+        r->chunks[i] = (reportChunk) { .s = s[i], .levels = VECTOR(int), .starts = VECTOR(size_t) };
     }
 
-    fclose(fp);
+    parallelFor(r->parts, r->parts, readChunk, r->chunks);
 
-    return count;
+    return r;
 }
 
+// Count of the reports of a chunk that are safe for a part, the reports are only read
+typedef struct {
+    const reportChunk * chunk;
+    int part;
+    uint64_t count;
+} reportTask;
 
-// Generate a subarray excluding the element at the specified index passsed
-void subAray(int *arr, int n, int index, int ** tmp) {
-    int j = 0;
-    for (int i = 0; i < n; i++) {
-        if (i == index) continue;
-        (*tmp) [j++] = arr[i];
-    }
-}
+// Counts the safe reports of a chunk, part 2 also counts the ones fixed by removing a level
+static void countChunk(int i, void * arg) {
+    reportTask * task = (reportTask *) arg + i;
+    const int * levels = task->chunk->levels.data;
+    const size_t * starts = task->chunk->starts.data;
 
-int countUnsafeReports(void) {
-    FILE * fp = fopen(filename, "r");
-    if (fp == NULL) {
-        printf("Error while opening file\n");
-        return 1;    
+    for (size_t k = 0; k + 1 < task->chunk->starts.len; k++) {
+        const int * arr = levels + starts[k];
+        int n = starts[k + 1] - starts[k];
+
+        if (isSafe(arr, n) || (task->part == 2 && isFixable(arr, n))) task->count++;
     }
+}
 
-    // Allocate memory for the array that will be read from the file
-    int *tmp, *tmp2;
-    int count = 0, n = 0, k = 0, check = 0;
+// Counts the safe reports for a part, the chunks are checked in parallel
+static uint64_t countReports(const reportList * r, int part) {
+    reportTask * tasks = calloc(r->parts, sizeof(reportTask));
+    for (int i = 0; i < r->parts; i++) tasks[i] = (reportTask) { .chunk = &r->chunks[i], .part = part };
 
-    // Read the file line by line, stop when the end of the file is reached
-    while ((n = readLine(fp, &tmp)) > 0) {
+    parallelFor(r->parts, r->parts, countChunk, tasks);
 
-        // Check if the line is safe
-        if (isSafe(tmp, n)) {free(tmp); continue; }
+    // Add up the counts of every chunk
+    uint64_t count = 0;
+    for (int i = 0; i < r->parts; i++) count += tasks[i].count;
 
-        // If the array wasn't safe, check if removing any layer makes it safe
-        tmp2 = (int *) malloc((n - 1) * sizeof(int));
-        for (int i = 0; i < n; i++) {
-            // Check if removing the layer at the current index makes the array safe
-            subAray(tmp, n, i, &tmp2);
-            if (isSafe(tmp2, n - 1)) { count++; break; }
-        }
+    free(tasks);
+    return count;
+}
 
-        // Free the memory allocated for the array
-        free(tmp);
-        free(tmp2);
-    }
+// Part 1: Count the number of safe reports
+static uint64_t safeReports(void * puzzle) {
+    return countReports(puzzle, 1);
+}
 
-    // Close the file
-    fclose(fp);
+// Part 2: Count the number of safe reports and unsafe reports that could be fixed by removing a layer
+static uint64_t dampenedReports(void * puzzle) {
+    return countReports(puzzle, 2);
+}
 
-    return count;
+// Free the levels of every chunk
+static void freeReports(void * puzzle) {
+    reportList * r = puzzle;
+    for (int i = 0; i < r->parts; i++) {
+        vectorFree(&r->chunks[i].levels);
+        vectorFree(&r->chunks[i].starts);
+    }
 
+    free(r->chunks);
+    free(r);
 }
-int main(void) {
 
-    // Part 1: Count the number of safe reports
-    int safeCount = countSafeReports();
-    printf("Part 1: \n\tNumber of safe reports: %d\n", safeCount);
+// Counts the safe reports of a stream one line at a time, only the levels
+// of the current report are kept in memory
+static int streamReports(inputStream * st, uint64_t answers[2]) {
+    vector levels = VECTOR(int);
+    reportCounts counts = { 0, 0 };
+    lineView ln;
+
+    while (streamLine(st, &ln)) {
+        // Lines without levels aren't reports
+        vectorClear(&levels);
+        scanner ls = lineScanner(ln);
+        int n = readLine(&ls, &levels);
+        if (n > 0) checkReport(levels.data, n, &counts);
+    }
 
-    // Part 2: Count the number of safe reports and unsafe reports that could be fixed by removing a layer
-    printf("Part 2: \n\tNumber of safe reports with a single bad level tolerance: %d\n", safeCount + countUnsafeReports());
+    answers[0] = counts.safe;
+    answers[1] = counts.safe + counts.fixable;
 
+    vectorFree(&levels);
     return 0;
 }
+
+const aocDay day02 = {
+    .number = 2,
+    .labels = { "Number of safe reports", "Number of safe reports with a single bad level tolerance" },
+    .parse = parseReports,
+    .part1 = safeReports,
+    .part2 = dampenedReports,
+    .release = freeReports,
+    .stream = streamReports,
+};
@@ -1,120 +1,246 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+
+#include "../common/day.h"
+#include "../common/checked.h"
+#include "../common/thread.h"
 
 ////////////////////////////////////////////////////////////////
 // Advent of Code 2024 Day 3                                  //
 // Link: https://adventofcode.com/2024/day/3                  //
 ////////////////////////////////////////////////////////////////
 
-#define filename "day03input.txt"
-
-// Matches two integers in the form n1,n2)
-int matchInt(FILE *fp) {
-    int n1, n2;
-    char ch;
-
-    // Read two integers 
-    if (fscanf(fp, "%d,%d", &n1, &n2) != 2) return 0;
-    // Read the closing parenthesis, if not found return 0
-    if (fgetc(fp) != ')') return 0;
+// States of the automaton recognising mul(X,Y), do() and don't(),
+// X and Y have 1 to 3 digits
+enum {
+    START,
+    M, MU, MUL, MUL_OPEN,     // "mul("
+    X1, X2, X3, COMMA,        // the digits of X and the comma
+    Y1, Y2, Y3,               // the digits of Y
+    D, DO, DO_OPEN,           // "do("
+    DON, DON_Q, DON_T, DON_T_OPEN, // "don't("
+    MUL_DONE, DO_DONE, DONT_DONE,  // an instruction was just read
+    STATES
+};
+
+// Tables of the automaton, next[state][byte] is the state after reading byte.
+// Reaching a state updates X as x * xScale[state] + digit * xDigit[state], so the
+// first digit resets it, the next ones are appended and other states keep it. Same for Y
+typedef struct {
+    uint8_t next[STATES][256];
+    uint8_t xScale[STATES], xDigit[STATES];
+    uint8_t yScale[STATES], yDigit[STATES];
+} dfa;
+
+// Execution of the instructions, kept between the chunks of a stream
+typedef struct {
+    uint8_t state;
+    uint8_t enabled;       // 0 after a don't(), 1 after a do()
+    uint8_t toggled;       // 1 once a do() or a don't() was read
+    uint32_t x, y;
+    uint64_t total[2];     // Sum of every mul, sum of the enabled ones
+    uint64_t untilToggle;  // Sum of the muls before the first do() or don't()
+} machine;
+
+// Builds the transition table. A byte that doesn't continue an instruction
+// starts over as if it was read in the start state, which is exact since 'm'
+// and 'd' only appear as the first character of the instructions
+static void buildDfa(dfa *a) {
+    // From every state a byte goes back to the start, or starts a new instruction
+    for (int s = 0; s < STATES; s++) {
+        for (int ch = 0; ch < 256; ch++) a->next[s][ch] = START;
+        a->next[s]['m'] = M;
+        a->next[s]['d'] = D;
+    }
 
-    // Print the result of the multiplication
-    return n1 * n2;
-}
+    a->next[M]['u'] = MU;
+    a->next[MU]['l'] = MUL;
+    a->next[MUL]['('] = MUL_OPEN;
+    a->next[Y1][')'] = MUL_DONE;
+    a->next[Y2][')'] = MUL_DONE;
+    a->next[Y3][')'] = MUL_DONE;
+    a->next[X1][','] = COMMA;
+    a->next[X2][','] = COMMA;
+    a->next[X3][','] = COMMA;
+
+    for (int ch = '0'; ch <= '9'; ch++) {
+        a->next[MUL_OPEN][ch] = X1;
+        a->next[X1][ch] = X2;
+        a->next[X2][ch] = X3;
+        a->next[COMMA][ch] = Y1;
+        a->next[Y1][ch] = Y2;
+        a->next[Y2][ch] = Y3;
+    }
 
-int readInstructions(void) {
-    FILE * fp = fopen(filename, "r");
-    if (fp == NULL) {
-        // If the file can't be opened, print an error message
-        printf("Error while opening file\n");
-        return 1;
+    a->next[D]['o'] = DO;
+    a->next[DO]['('] = DO_OPEN;
+    a->next[DO_OPEN][')'] = DO_DONE;
+    a->next[DO]['n'] = DON;
+    a->next[DON]['\''] = DON_Q;
+    a->next[DON_Q]['t'] = DON_T;
+    a->next[DON_T]['('] = DON_T_OPEN;
+    a->next[DON_T_OPEN][')'] = DONT_DONE;
+
+    // Only the states of the digits change X and Y
+    for (int s = 0; s < STATES; s++) {
+        a->xScale[s] = s == X1 ? 0 : s == X2 || s == X3 ? 10 : 1;
+        a->xDigit[s] = s == X1 || s == X2 || s == X3;
+        a->yScale[s] = s == Y1 ? 0 : s == Y2 || s == Y3 ? 10 : 1;
+        a->yDigit[s] = s == Y1 || s == Y2 || s == Y3;
     }
-    
-    char ch;
+}
 
-    // Match the string "mul(" that is part of the instruction mul(x,y)
-    char match[] = "mul(";
+// Runs the instructions in [p, end) one byte at a time. The values and the totals are
+// updated with arithmetic on what the new state is.
+// Most of the memory is noise: outside of an instruction only an 'm' or a 'd' can start
+// a new one, so the bytes before the next of them are skipped with vector compares
+static void runInstructions(const dfa *a, machine *m, const char *p, const char *end) {
+    uint32_t state = m->state, enabled = m->enabled, toggled = m->toggled, x = m->x, y = m->y;
+    uint64_t total = m->total[0], totalEnabled = m->total[1], untilToggle = m->untilToggle;
+
+    for (; p < end; p++) {
+        // The states after an instruction read the next byte like the start one
+        if ((state == START || state >= MUL_DONE) && *p != 'm' && *p != 'd') {
+            p = findEither(p, end, 'm', 'd');
+            if (p == end) { state = START; break; }
+        }
 
-    int i = 0;
-    int total = 0;
+        uint8_t ch = *p;
+        uint32_t digit = ch - '0';
+        state = a->next[state][ch];
 
-    // Read till the end of the of the file
-    while ((ch = fgetc(fp)) != EOF) {
+        x = x * a->xScale[state] + digit * a->xDigit[state];
+        y = y * a->yScale[state] + digit * a->yDigit[state];
 
-        // If the current character is the same as the current character of the match string, increment the index
-        if (!(ch == match[i++])) i = 0;
-        
-        // If string has been matched, read two integers and add their product to the total
-        if (i == 4) {
-            total += matchInt(fp);
-            i = 0;
-        }
+        // Add the product when a mul is complete, and turn the muls on and off
+        uint64_t product = (uint64_t) (state == MUL_DONE) * x * y;
+        CHECKED_ADD(total, product);
+        totalEnabled += product * enabled;
+        untilToggle += product * !toggled;
+        enabled = (enabled & (state != DONT_DONE)) | (state == DO_DONE);
+        toggled |= state >= DO_DONE;
     }
 
-    fclose(fp);
-
-    return total;
-
+    *m = (machine) { state, enabled, toggled, x, y, { total, totalEnabled }, untilToggle };
 }
 
-int readInstructions2(void) {
-    FILE * fp = fopen(filename, "r");
-    if (fp == NULL) {
-        // If the file can't be opened, print an error message
-        printf("Error while opening file\n");
-        return 1;
-    }
-    
-
-    char ch;
+// Finishes the instruction cut by the end of a chunk reading the bytes after it.
+// It stops as soon as the instruction is over or another one would start, so
+// every instruction is only read by the chunk it starts in
+static void finishInstruction(const dfa *a, machine *m, const char *p, const char *end) {
+    while (p < end && m->state != START && m->state < MUL_DONE) {
+        uint8_t next = a->next[m->state][(uint8_t) *p];
+        if (next == START || next == M || next == D) break;
 
-    // Match the string "mul(" that is part of the instruction mul(x,y)
-    char matchA[] = "mul(";
-    int a = 0;
+        runInstructions(a, m, p, p + 1);
+        p++;
+    }
+}
 
-    // Match the string equivalent to the instruction do()
-    char matchB[] = "do()";
-    int b = 0;
+// The corrupted memory and the automaton that reads it, the memory is the mapped input
+typedef struct {
+    dfa a;
+    const char *data;
+    size_t size;
+} memory;
+
+// Part of the memory executed by a thread
+typedef struct {
+    const dfa *a;
+    const char *start, *end;
+    const char *last; // End of the whole input
+    machine m;
+} memoryChunk;
+
+// Executes a chunk as if the muls were enabled at its start
+static void runChunk(int i, void *arg) {
+    memoryChunk *c = (memoryChunk *) arg + i;
+
+    c->m = (machine) { .state = START, .enabled = 1 };
+    runInstructions(c->a, &c->m, c->start, c->end);
+    finishInstruction(c->a, &c->m, c->end, c->last);
+}
 
-    // Match the string equivalent to the instruction don't()
-    char matchC[] = "don't()";
-    int c = 0;
+// Builds the automaton, the instructions are read in place by the parts
+static void * parseMemory(const inputFile * in) {
+    memory * mem = malloc(sizeof(memory));
+    buildDfa(&mem->a);
+    mem->data = in->data;
+    mem->size = in->size;
 
-    int total = 0;
-    int canDo = 1;	
+    return mem;
+}
 
-    // Read till the end of the of the file
-    while ((ch = fgetc(fp)) != EOF) {
+// Executes every instruction of the memory once, the totals of both parts come out
+// of the same pass. The memory is split in chunks executed in parallel, each one as if
+// the muls were enabled at its start. Then the chunks are stitched in order: a chunk
+// starting disabled loses the muls before its first do() or don't(), and passes on the
+// state it ends with, or the one it started with if it has neither
+static machine runMemory(const memory * mem) {
+    int parts = chunksFor(mem->size);
+
+    memoryChunk *chunks = calloc(parts, sizeof(memoryChunk));
+    for (int i = 0; i < parts; i++) {
+        chunks[i].a = &mem->a;
+        chunks[i].start = mem->data + mem->size * i / parts;
+        chunks[i].end = mem->data + mem->size * (i + 1) / parts;
+        chunks[i].last = mem->data + mem->size;
+    }
 
-        // If the current character is the same as the current character of the match string, increment the index
-        if (!(ch == matchA[a++])) a = 0;
-        if (!(ch == matchB[b++])) b = 0;
-        if (!(ch == matchC[c++])) c = 0;
+    parallelFor(parts, parts, runChunk, chunks);
 
-        // If string has been matched and the mul function is active, read two integers and add their product to the total
-        if (a == 4 && canDo) {	
-            total += matchInt(fp);
-            a = 0;
-        }
+    machine m = { .state = START, .enabled = 1 };
+    for (int i = 0; i < parts; i++) {
+        machine * c = &chunks[i].m;
 
-        // If string has been matched activate or deactivate the mul function
-        if (b == 4) {canDo = 1; b = 0;}
-        if (c == 7) {canDo = 0; c = 0;}
-            
+        CHECKED_ADD(m.total[0], c->total[0]);
+        CHECKED_ADD(m.total[1], m.enabled ? c->total[1] : c->total[1] - c->untilToggle);
+        if (c->toggled) m.enabled = c->enabled;
     }
 
-    fclose(fp);
+    free(chunks);
+    return m;
+}
+
+// Part 1: Sum and execute all multiply instructions
+static uint64_t sumAll(void * puzzle) {
+    return runMemory(puzzle).total[0];
+}
 
-    return total;
+// Part 2: Sum and execute all multiply instructions if do() is active
+static uint64_t sumEnabled(void * puzzle) {
+    return runMemory(puzzle).total[1];
+}
 
+// Free the automaton
+static void freeMemory(void * puzzle) {
+    free(puzzle);
 }
 
-int main(void) {
-    // Part 1: Sum and execute all multiply instructions
-    printf("Part 1: \n\tTotal: %d\n", readInstructions());
+// Executes the instructions a chunk at a time, the automaton carries its state
+// between the chunks so nothing has to be kept
+static int streamInstructions(inputStream * st, uint64_t answers[2]) {
+    dfa a;
+    buildDfa(&a);
 
-    // Part 2: Sum and execute all multiply instructions if do() is active
-    printf("Part 2: \n\tTotal: %d", readInstructions2());
+    machine m = { .state = START, .enabled = 1 };
+    while (streamRead(st)) {
+        runInstructions(&a, &m, st->s.pos, st->s.end);
+        st->s.pos = st->s.end;
+    }
 
+    answers[0] = m.total[0];
+    answers[1] = m.total[1];
     return 0;
 }
+
+const aocDay day03 = {
+    .number = 3,
+    .labels = { "Total", "Total" },
+    .parse = parseMemory,
+    .part1 = sumAll,
+    .part2 = sumEnabled,
+    .release = freeMemory,
+    .stream = streamInstructions,
+};
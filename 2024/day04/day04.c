@@ -1,107 +1,97 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "../common/day.h"
+#include "../common/grid.h"
+#include "../common/thread.h"
+
 ////////////////////////////////////////////////////////////////
 // Advent of Code 2024 Day 4                                  //
 // Link: https://adventofcode.com/2024/day/4                  //
 ////////////////////////////////////////////////////////////////
 
-#define filename "day04input.txt"
-
-// Get the dimensions of the file
-// This function takes two pointers, *rows and *cols, and fills them in with the number of rows and columns in the file respectively
-void getFileDimensions(int *rows, int *cols) {
-    // Open the file
-    FILE *file = fopen(filename, "r");  
-    if (file == NULL) {
-        printf("Error while opening the file.\n");
-        // If the file can't be opened, exit the program
-        exit(1);
-    }
-
-    *rows = 1;
-    *cols = 0;
-    char ch;
-
-    // Read the file character by character
-    while ((ch = fgetc(file)) != EOF) {
-        // Count the number of columns for the first row only
-        if (*rows == 1 && ch != '\n') {
-            // Only count the number of columns on the first row
-            *cols += 1;
-        }
+// The letters of the word search, with a border of 3 cells so any
+// XMAS starting inside the grid can be read without checking the bounds
+typedef struct {
+    grid g;
+} wordSearch;
 
-        // Count the number of rows by counting the newlines
-        if (ch == '\n') {
-            *rows += 1;
-        }      
-    }
+// Check if XMAS or SAMX starts at the cell and goes on in the direction,
+// step is the offset between a cell and the next one in the direction.
+// Reading both ways from the first letter finds every XMAS of the 8 directions once
+static int matchForward(const char * cell, ptrdiff_t step) {
+    if (cell[0] == 'X') return cell[step] == 'M' && cell[2 * step] == 'A' && cell[3 * step] == 'S';
+    if (cell[0] == 'S') return cell[step] == 'A' && cell[2 * step] == 'M' && cell[3 * step] == 'X';
 
-    fclose(file);
+    return 0;
 }
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define BLOCK 32
+
+// Returns a bit for every one of the 32 cells from p where XMAS or SAMX starts in the direction
+static inline uint32_t matchBlock(const char * p, ptrdiff_t step) {
+    __m256i c0 = _mm256_loadu_si256((const __m256i *) p);
+    __m256i c1 = _mm256_loadu_si256((const __m256i *) (p + step));
+    __m256i c2 = _mm256_loadu_si256((const __m256i *) (p + 2 * step));
+    __m256i c3 = _mm256_loadu_si256((const __m256i *) (p + 3 * step));
+    __m256i x = _mm256_set1_epi8('X'), m = _mm256_set1_epi8('M');
+    __m256i a = _mm256_set1_epi8('A'), s = _mm256_set1_epi8('S');
+
+    __m256i xmas = _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi8(c0, x), _mm256_cmpeq_epi8(c1, m)),
+                                    _mm256_and_si256(_mm256_cmpeq_epi8(c2, a), _mm256_cmpeq_epi8(c3, s)));
+    __m256i samx = _mm256_and_si256(_mm256_and_si256(_mm256_cmpeq_epi8(c0, s), _mm256_cmpeq_epi8(c1, a)),
+                                    _mm256_and_si256(_mm256_cmpeq_epi8(c2, m), _mm256_cmpeq_epi8(c3, x)));
+
+    return _mm256_movemask_epi8(_mm256_or_si256(xmas, samx));
+}
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define BLOCK 16
+
+// Returns a bit for every one of the 16 cells from p where XMAS or SAMX starts in the direction
+static inline uint32_t matchBlock(const char * p, ptrdiff_t step) {
+    __m128i c0 = _mm_loadu_si128((const __m128i *) p);
+    __m128i c1 = _mm_loadu_si128((const __m128i *) (p + step));
+    __m128i c2 = _mm_loadu_si128((const __m128i *) (p + 2 * step));
+    __m128i c3 = _mm_loadu_si128((const __m128i *) (p + 3 * step));
+    __m128i x = _mm_set1_epi8('X'), m = _mm_set1_epi8('M');
+    __m128i a = _mm_set1_epi8('A'), s = _mm_set1_epi8('S');
+
+    __m128i xmas = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(c0, x), _mm_cmpeq_epi8(c1, m)),
+                                 _mm_and_si128(_mm_cmpeq_epi8(c2, a), _mm_cmpeq_epi8(c3, s)));
+    __m128i samx = _mm_and_si128(_mm_and_si128(_mm_cmpeq_epi8(c0, s), _mm_cmpeq_epi8(c1, a)),
+                                 _mm_and_si128(_mm_cmpeq_epi8(c2, m), _mm_cmpeq_epi8(c3, x)));
+
+    return _mm_movemask_epi8(_mm_or_si128(xmas, samx));
+}
+#endif
 
-// Get the matrix from the file
-char ** getMatrix(int rows, int cols) {
-    FILE * fp = fopen(filename, "r");
-    if (fp == NULL) {
-        printf("Error while opening file\n");
-        return NULL;
-    }
-
-    // Allocate the matrix to the number of rows
-    char ** mat = calloc(rows, sizeof(char *));
-
-    // Read the file line by line and store it in the matrix
-    for (int i = 0; i < rows; i++) {
-        mat[i] = calloc(cols, sizeof(char));
-        fscanf(fp, "%s\n", mat[i]);
-    }
+// Count the number of XMAS starting in the rows [r0, r1) of the matrix.
+// Every row is compared with itself shifted by one, two and three cells in the 4 directions
+// going forward, a whole block of columns at a time
+static uint64_t countXmasRows(const grid * g, int r0, int r1) {
 
-    fclose(fp);
+    // Right, down, down right and down left, as offsets in the grid
+    const ptrdiff_t dirs[4] = { GRID_STEP(*g, 0, 1), GRID_STEP(*g, 1, 0), GRID_STEP(*g, 1, 1), GRID_STEP(*g, 1, -1) };
 
-    return mat;
-}
+    uint64_t count = 0;
 
-// Check if the direction is valid
-int checkDirection(char ** mat, int r, int c, int dirx, int diry) {
-    char * xmas = "XMAS";
+    for (int r = r0; r < r1; r++) {
+        const char * row = &GRID_AT(*g, r, 0);
+        int c = 0;
 
-    // Check if every char in the direction is part of XMAS
-    for (int i = 0; i < 4; i++) {
-        if (mat[r + dirx * i][c + diry * i] != xmas[i]) return 0;
-    }
-
-    return 1;
-}
+#ifdef BLOCK
+        // The border of 3 cells covers the shifted reads of the blocks that end inside the row
+        for (; c + BLOCK <= g->cols; c += BLOCK) {
+            for (int i = 0; i < 4; i++) count += __builtin_popcount(matchBlock(&row[c], dirs[i]));
+        }
+#endif
 
-// Count the number of XMAS appearing in the matrix
-int countXmas(char ** mat, int rows, int cols) {
-
-    // The 8 possible directions to check
-    int dirs[8][2] = {
-        { -1, -1 }, { -1,  0 }, { -1,  1 },  //  ↖ ↑ ↗
-        {  0, -1 },             {  0,  1 },  //  ← ch →
-        {  1, -1 }, {  1,  0 }, {  1,  1 },  //  ↙ ↓ ↘
-    };
-
-    int count = 0;
-
-    // Check every elem in the matrix
-    for (int r = 0; r < rows; r++) {
-        for (int c = 0; c < cols; c++) {
-            // Only X can start an XMAS
-            if (mat[r][c] != 'X') continue;
-            
-            // Check the 8 directions
-            for (int i = 0; i < 8; i++) {
-                // Check if the direction fits the boundaries of the matrix
-                if (r + dirs[i][0] * 3 >= rows || c + dirs[i][1] * 3 >= cols) continue;
-                if (r + dirs[i][0] * 3 < 0 || c + dirs[i][1] * 3 < 0) continue; 
-                
-                // Increase the count if the direction is valid
-                count += (checkDirection(mat, r, c, dirs[i][0], dirs[i][1]));
-            }
+        // Check the columns left one by one
+        for (; c < g->cols; c++) {
+            for (int i = 0; i < 4; i++) count += matchForward(&row[c], dirs[i]);
         }
     }
 
@@ -109,7 +99,7 @@ int countXmas(char ** mat, int rows, int cols) {
 }
 
 // Check if the direction forms the half of a cross
-int isCross(char t, char b) {
+static int isCross(char t, char b) {
     // Checks if the two params are parts of the line MAS
     if (t == 'M' && b == 'S') return 1;
     if (b == 'M' && t == 'S') return 1;
@@ -117,19 +107,24 @@ int isCross(char t, char b) {
     return 0;
 }
 
-int countMas(char ** mat, int rows, int cols) {
-    int count = 0;
+// Count the number of crosses made by MAS centered in the rows [r0, r1) of the matrix
+static uint64_t countMasRows(const grid * g, int r0, int r1) {
+    uint64_t count = 0;
+    const ptrdiff_t up = GRID_STEP(*g, -1, 0), down = GRID_STEP(*g, 1, 0);
+
+    // Check every elem in the rows, the cells of the border are never part of a cross
+    for (int r = r0; r < r1; r++) {
+        const char * row = &GRID_AT(*g, r, 0);
 
-    // Check every elem in the matrix
-    for (int r = 1; r < rows - 1; r++) {
-        for (int c = 1; c < cols - 1; c++) {
+        for (int c = 0; c < g->cols; c++) {
             // Only A can be the center of a cross
-            if (mat[r][c] != 'A') continue;
+            if (row[c] != 'A') continue;
 
             // Skip to the next elem if one of the line isn't part of the cross
-            if (!isCross(mat[r - 1][c - 1], mat[r + 1][c + 1])) continue;
-            if (!isCross(mat[r - 1][c + 1], mat[r + 1][c - 1])) continue;
-            
+            const char * a = &row[c];
+            if (!isCross(a[up - 1], a[down + 1])) continue;
+            if (!isCross(a[up + 1], a[down - 1])) continue;
+
             count ++;
         }
     }
@@ -137,28 +132,86 @@ int countMas(char ** mat, int rows, int cols) {
     return count;
 }
 
-// Free the dynamically allocated matrix
-void freeMatrix(char ** mat, int rows) {
-    for (int i = 0; i < rows; i++) {
-        free(mat[i]);
+// Band of rows counted by a thread and its count. The 3 rows after the band are
+// only read, to finish the words going down from its last rows, and the row before
+// it to check the crosses centered in its first row, so every match is counted once
+typedef struct {
+    const wordSearch * ws;
+    int r0;
+    int r1;
+    uint64_t count;
+} rowBand;
+
+// Count the number of XMAS starting in a band
+static void xmasBand(int i, void * arg) {
+    rowBand * band = (rowBand *) arg + i;
+    band->count = countXmasRows(&band->ws->g, band->r0, band->r1);
+}
+
+// Count the number of crosses made by MAS centered in a band
+static void masBand(int i, void * arg) {
+    rowBand * band = (rowBand *) arg + i;
+    band->count = countMasRows(&band->ws->g, band->r0, band->r1);
+}
+
+// Splits the grid in bands of rows counted in parallel by task and adds up their counts
+static uint64_t countBands(const wordSearch * ws, void (*task)(int i, void * arg)) {
+    const grid * g = &ws->g;
+
+    int parts = chunksFor((size_t) g->rows * g->cols);
+
+    rowBand * bands = calloc(parts, sizeof(rowBand));
+    for (int i = 0; i < parts; i++) {
+        bands[i] = (rowBand) {
+            .ws = ws,
+            .r0 = (int) ((int64_t) g->rows * i / parts),
+            .r1 = (int) ((int64_t) g->rows * (i + 1) / parts),
+        };
     }
 
-    free(mat);
-} 
+    parallelFor(parts, parts, task, bands);
 
-int main(void) {
-    int rows, cols;
-    getFileDimensions(&rows, &cols);
-    char ** mat = getMatrix(rows, cols);
+    // Add up the counts of every band
+    uint64_t count = 0;
+    for (int i = 0; i < parts; i++) {
+        count += bands[i].count;
+    }
 
-    // Part 1: Count the number of XMAS in every of the 8 directions
-    printf("Part 1: \n\tTotal occurrences of XMAS: %d\n", countXmas(mat, rows, cols));
-    
-    // Part 2: Count the number of crosses made by MAS
-    printf("Part 2: \n\tTotal occurrences of X-MAS: %d\n", countMas(mat, rows, cols));
+    free(bands);
+    return count;
+}
 
-    // Free the dynamically allocated matrix
-    freeMatrix(mat, rows);
+// Reads the word search from the input
+static void * parseWordSearch(const inputFile * in) {
+    wordSearch * ws = calloc(1, sizeof(wordSearch));
 
-    return 0;
+    if (gridFromInput(&ws->g, in, 3, '.')) { free(ws); return NULL; }
+
+    return ws;
 }
+
+// Part 1: Count the number of XMAS in every of the 8 directions
+static uint64_t partXmas(void * puzzle) {
+    return countBands(puzzle, xmasBand);
+}
+
+// Part 2: Count the number of crosses made by MAS
+static uint64_t partMas(void * puzzle) {
+    return countBands(puzzle, masBand);
+}
+
+// Free the grid of the word search
+static void freeWordSearch(void * puzzle) {
+    wordSearch * ws = puzzle;
+    gridFree(&ws->g);
+    free(ws);
+}
+
+const aocDay day04 = {
+    .number = 4,
+    .labels = { "Total occurrences of XMAS", "Total occurrences of X-MAS" },
+    .parse = parseWordSearch,
+    .part1 = partXmas,
+    .part2 = partMas,
+    .release = freeWordSearch,
+};
@@ -1,195 +1,419 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <ctype.h>
+#include <string.h>
+
+#include "../common/day.h"
+#include "../common/checked.h"
+#include "../common/hash.h"
+#include "../common/thread.h"
+#include "../common/vector.h"
 
 ////////////////////////////////////////////////////////////////
 // Advent of Code 2024 Day 5                                  //
 // Link: https://adventofcode.com/2024/day/5                  //
 ////////////////////////////////////////////////////////////////
 
-#define filename "day05input.txt"
+// Pages with a smaller id find their row in an array, the others in a hash table
+#define DENSE_PAGES 4096
+
+// The rules compiled in two matrices of bits: the bit b of the row a of after is set if
+// the page a must come before the page b, before is the same matrix transposed so a row has
+// the pages that must come before its page. The pages are numbered in the order they first appear
+// in the rules, so the matrix only has a row for the pages that have rules whatever
+// the size of their ids
+typedef struct {
+    int * index;      // Row of every page id below dense, -1 if the page has no rules
+    int dense;
+    hashTable large;  // Rows of the pages from DENSE_PAGES
+    int size;         // Number of pages with rules
+    int words;        // Number of 64 bit words of a row
+    uint64_t * after;
+    uint64_t * before;
+} ruleMatrix;
+
+// Updates read by a thread, the pages of the update i are pages[starts[i]]
+// to pages[starts[i + 1] - 1]
+typedef struct {
+    scanner s;
+    vector pages;
+    vector starts;
+    int err;           // Set if a page of the chunk doesn't fit in an int
+} updateChunk;
+
+// The compiled ordering rules and the updates, split in chunks at newlines
+typedef struct {
+    ruleMatrix order;
+    int parts;
+    updateChunk * chunks;
+} manual;
+
+// Parses the rules of the file in the vector of int32_t, the rule i says the page
+// rules[2 * i] comes before the page rules[2 * i + 1]. Returns 0 on success, 1 if a page
+// doesn't fit in an int32_t
+static int parseRules(scanner * s, vector *rules) {
+    lineView ln;
+    int64_t a, b;
+
+    // Read all the rules till the blank line
+    while (nextLine(s, &ln)) {
+        scanner ls = lineScanner(ln);
+        if (!nextInt(&ls, &a) || !nextInt(&ls, &b)) break;
+        if (a > INT32_MAX || b > INT32_MAX) return 1;
+
+        // Add both pages of the new rule at the end of the vector
+        vectorReserve(rules, rules->len + 2);
+        int32_t * rule = (int32_t *) rules->data + rules->len;
+        rule[0] = a; rule[1] = b;
+        rules->len += 2;
+    }
+
+    return 0;
+}
 
-// Parses the file and returns the number of rules
-int parseRules(FILE * fp, int ** *rules) {
+// Parses a line appending its pages to the vector, returns the number of pages read
+// or -1 if a page doesn't fit in an int
+static int parseLine(scanner *s, vector *arr) {
     int n = 0;
-    char line[256];
-    int a, b;
-    int *tmp = NULL;
+    int64_t tmp;
+    lineView ln;
 
-    // Read all the rules till the blank line
-    while (fgets(line, sizeof(line), fp) != NULL) {
-        if (sscanf(line, "%d|%d\n", &a, &b) != 2) break;
+    // Stop if the end of the input is reached
+    if (!nextLine(s, &ln)) return 0;
 
-        // Reallocate the array and add the new value
-        *rules = (int **) realloc(*rules, (n + 1) * sizeof(int));
-        tmp = (int *) calloc(2, sizeof(int));
-        
-        tmp[0] = a; tmp[1] = b;
+    // Read every number till the end of the line
+    scanner ls = lineScanner(ln);
+    while (nextInt(&ls, &tmp)) {
+        if (tmp > INT32_MAX) return -1;
 
-        (*rules)[n++] = tmp;
+        // Add the number to the array
+        *(int *) vectorPush(arr) = tmp;
+        n++;
     }
 
     return n;
 }
 
-int parseLine(FILE *fp, int **arr) {
-    if (arr == NULL) return 0;
-
-    // Initialize the array to a single element
-    *arr = (int *) calloc(1, sizeof(int));
+// Returns the row of a page in the matrix, -1 if there are no rules about it
+static inline int pageRow(const ruleMatrix * order, int page) {
+    if (page < DENSE_PAGES) return page < order->dense ? order->index[page] : -1;
+    return hashGet(&order->large, page);
+}
 
-    char ch;
-    int n = 0, i;
-    char tmp[10];
+// Returns where the row of a page is stored, adding the page if it's not there yet.
+// Returns NULL if the table couldn't grow
+static int * rowSlot(ruleMatrix * order, int page) {
+    if (page < DENSE_PAGES) return &order->index[page];
+    return hashAdd(&order->large, page);
+}
 
-    // Read till the end of the line or the end of the file
-    while ((ch = fgetc(fp)) != '\n' && ch != EOF) {
-        if (!isdigit(ch)) continue;
+// Frees the memory of the matrix
+static void freeRules(ruleMatrix * order) {
+    free(order->index); hashFree(&order->large);
+    free(order->after); free(order->before);
+}
 
-        i = 0;
+// Compiles the rules parsed by parseRules in the matrix, returns 0 on success
+static int compileRules(const vector * rules, ruleMatrix * order) {
+    const int32_t * r = rules->data;
+
+    // Size the array by the largest small id, and the table so it never grows
+    // even if every page of the rules has a large id
+    uint32_t large = 0;
+    order->dense = 1;
+    for (size_t i = 0; i < rules->len; i++) {
+        if (r[i] >= DENSE_PAGES) large++;
+        else if (r[i] >= order->dense) order->dense = r[i] + 1;
+    }
 
-        // Read the number digit by digit as a string
-        do {
-            if (i < sizeof(tmp) - 1) tmp[i++] = ch;
-            ch = fgetc(fp);
-        } while (isdigit(ch));
-        tmp[i] = '\0';
+    order->index = malloc(order->dense * sizeof(int));
+    if (order->index == NULL || hashInit(&order->large, large, -1)) return 1;
 
-        // Reallocate the array with one more element
-        int *newArr = (int *) realloc(*arr, (n + 1) * sizeof(int));
-        if (newArr == NULL) {
-            // If realloc fails, free the array and exit
-            perror("Memory allocation failed");
-            free(*arr);
-            *arr = NULL;
-            exit(EXIT_FAILURE);
-        }
+    for (int p = 0; p < order->dense; p++) order->index[p] = -1;
 
-        *arr = newArr;
+    // Give a row to every page the first time it's found
+    order->size = 0;
+    for (size_t i = 0; i < rules->len; i++) {
+        int * row = rowSlot(order, r[i]);
+        if (row == NULL) return 1;
+        if (*row < 0) *row = order->size++;
+    }
 
-        // Convert the string to an integer and add it to the array
-        (*arr)[n++] = atoi(tmp);
+    order->words = (order->size + 63) / 64;
+    order->after = calloc((size_t) order->size * order->words + 1, sizeof(uint64_t));
+    order->before = calloc((size_t) order->size * order->words + 1, sizeof(uint64_t));
+    if (order->after == NULL || order->before == NULL) return 1;
 
-        if (ch == EOF || ch == '\n') break;
+    for (size_t i = 0; i + 1 < rules->len; i += 2) {
+        int a = pageRow(order, r[i]), b = pageRow(order, r[i + 1]);
+        order->after[(size_t) a * order->words + b / 64] |= 1ull << (b % 64);
+        order->before[(size_t) b * order->words + a / 64] |= 1ull << (a % 64);
     }
 
-    return n;
+    return 0;
 }
 
-// Checks if the array matches the rule a comes before b
-int matches(int a, int b, int * arr, int n) {
-    int posA = -1, posB = -1;
+// Returns 1 if there is a rule where the page a comes before the page b
+static inline int ruleBefore(const ruleMatrix * order, int a, int b) {
+    int ra = pageRow(order, a), rb = pageRow(order, b);
+    if (ra < 0 || rb < 0) return 0;
 
-    // Find the positions of a and b
-    for (int i = 0; i < n; i++) {
-        if (arr[i] == a) posA = i;
-        if (arr[i] == b) posB = i;
-    }
+    return (order->after[(size_t) ra * order->words + rb / 64] >> (rb % 64)) & 1;
+}
 
-    // If either a or b is not found the rule is enforced
-    if (posA == -1 || posB == -1) return 1;
-    if (posA < posB) return 1;
+// Checks if the array matches all the rules in one pass: no page can have a rule
+// to come before one of the pages seen before it. seen has a bit for every row of the
+// matrix set to 0, and it's left that way
+static int enforce(const ruleMatrix * order, uint64_t * seen, const int * arr, int n) {
+    int valid = 1, i;
 
-    return 0;
-}
+    for (i = 0; i < n && valid; i++) {
+        int row = pageRow(order, arr[i]);
+        if (row < 0) continue;
+
+        // Compare the pages that must come after this one with the ones already seen
+        const uint64_t * after = &order->after[(size_t) row * order->words];
+        for (int w = 0; w < order->words; w++) {
+            if (after[w] & seen[w]) { valid = 0; break; }
+        }
 
-// Checks if the array matches all the rules
-int enforce(int ** rules, int * arr, int nRules, int n) {
-    for (int i = 0; i < nRules; i++) {
-        // If any rule is not enforced, return 0
-        if (matches(rules[i][0], rules[i][1], arr, n)) continue;
+        seen[row / 64] |= 1ull << (row % 64);
+    }
 
-        return 0;
+    // Clear only the bits that were set
+    for (int j = 0; j < i; j++) {
+        int row = pageRow(order, arr[j]);
+        if (row >= 0) seen[row / 64] = 0;
     }
-    return 1;
+
+    return valid;
 }
 
 // Returns the median of the array
-int median(int * arr, int n) {
+static int median(const int * arr, int n) {
     return arr[n / 2];
 }
 
 // Returns 1 if a comes before b using the rules
-int comesBefore(int a, int b, int ** rules, int nRules) {
+static int comesBefore(int a, int b, const ruleMatrix * order) {
     // Check if any rule where a comes before b exists
-    for (int i = 0; i < nRules; i++) {
-        if (rules[i][0] == a && rules[i][1] == b) return 1;
-        if (rules[i][0] == b && rules[i][1] == a) return 0;
-    }
+    if (ruleBefore(order, a, b)) return 1;
+    if (ruleBefore(order, b, a)) return 0;
 
     // If no rule is found, the smaller one comes first
     return a < b;
 }
 
-// Swaps two elements of the array
-void swap(int *array, int i, int j) {
-    int temp = array[i];
-    array[i] = array[j];
-    array[j] = temp;
+// Sorts the array using a merge sort, tmp must have room for n elements
+static void sort(int *array, int *tmp, int n, const ruleMatrix * order) {
+    if (n < 2) return;
+
+    int half = n / 2;
+    sort(array, tmp, half, order);
+    sort(array + half, tmp, n - half, order);
+
+    // Merge the two sorted halves, taking from the left one when it's a tie so the sort is stable
+    int i = 0, j = half, k = 0;
+    while (i < half && j < n) {
+        if (comesBefore(array[j], array[i], order)) tmp[k++] = array[j++];
+        else tmp[k++] = array[i++];
+    }
+    while (i < half) tmp[k++] = array[i++];
+
+    // What is left of the right half is already in place
+    memcpy(array, tmp, k * sizeof(int));
 }
 
-// Sorts the array using selection sort
-void sort(int *array, int n, int **rules, int nRules) {
-    for (int i = 0; i < n - 1; i++) {
-        int minIndex = i;
+// Returns the median of the update without sorting it. When the rules order every pair of
+// pages of the update, the page in the middle is the one with exactly n / 2 pages of the update
+// that must come before it. mask has a bit for every row of the matrix set to 0, and it's left that way.
+// Returns -1 if a page has no rule with another page of the update, or if the rules make a loop
+static int selectMedian(const ruleMatrix * order, uint64_t * mask, const int * arr, int n) {
+    int median = -1, marked = n;
+
+    // Mark the pages of the update, a page without rules is ordered by its id so the update must be sorted
+    for (int i = 0; i < n; i++) {
+        int row = pageRow(order, arr[i]);
+        if (row < 0) { marked = i; break; }
+        mask[row / 64] |= 1ull << (row % 64);
+    }
 
-        // Find the index of the minimum element
-        for (int j = i + 1; j < n; j++) {
-            if (comesBefore(array[j], array[minIndex], rules, nRules)) minIndex = j;
+    // Every page has to be checked, the update is only ordered by the rules if all of them are
+    for (int i = 0; i < n && marked == n; i++) {
+        int row = pageRow(order, arr[i]);
+        const uint64_t * before = &order->before[(size_t) row * order->words];
+        const uint64_t * after = &order->after[(size_t) row * order->words];
+
+        // Count the pages that must come before this one and the ones that are ordered with it
+        int preceding = 0, related = 0;
+        for (int w = 0; w < order->words; w++) {
+            preceding += __builtin_popcountll(before[w] & mask[w]);
+            related += __builtin_popcountll((before[w] | after[w]) & mask[w]);
         }
-        
-        // Swap the minimum element with the current element
-        if (minIndex != i) swap(array, i, minIndex);
+
+        // A page without a rule with every other one is ordered by its id, which isn't in the matrix
+        if (related != n - 1) { median = -1; break; }
+
+        if (preceding == n / 2) median = arr[i];
+    }
+
+    // Clear only the bits that were set
+    for (int i = 0; i < marked; i++) {
+        int row = pageRow(order, arr[i]);
+        mask[row / 64] = 0;
+    }
+
+    return median;
+}
+
+// Returns the median of an invalid update once sorted. seen is a mask of the rows of the
+// matrix set to 0, sorted a buffer reused for the sorts
+static int repairedMedian(const ruleMatrix * order, uint64_t * seen, vector * sorted, const int * arr, int n) {
+#ifndef DAY05_FULL_SORT
+    // Only the median is needed, find it straight away if the rules order the whole update
+    int mid = selectMedian(order, seen, arr, n);
+    if (mid >= 0) return mid;
+#else
+    (void) seen;
+#endif
+
+    // Sort a copy of the invalid update using the rules, the second half of the buffer is for the merges
+    vectorReserve(sorted, 2 * n);
+    memcpy(sorted->data, arr, n * sizeof(int));
+    sort(sorted->data, (int *) sorted->data + n, n, order);
+
+    return median(sorted->data, n);
+}
+
+// Reads the updates of a chunk, empty lines aren't updates
+static void readChunk(int i, void * arg) {
+    updateChunk * chunk = (updateChunk *) arg + i;
+
+    *(size_t *) vectorPush(&chunk->starts) = 0;
+    while (chunk->s.pos < chunk->s.end) {
+        int n = parseLine(&chunk->s, &chunk->pages);
+        if (n < 0) { chunk->err = 1; break; }
+        if (n > 0) *(size_t *) vectorPush(&chunk->starts) = chunk->pages.len;
     }
 }
 
+// Frees the memory of the rules and of the updates
+static void freeManual(void * puzzle) {
+    manual * m = puzzle;
+    freeRules(&m->order);
 
-int main(void) {
-    // Open the file to read from
-    FILE * fp = fopen(filename, "r");
-    if (fp == NULL) {
-        printf("Error while opening file\n");
-        return 1;
+    for (int i = 0; i < m->parts; i++) {
+        vectorFree(&m->chunks[i].pages);
+        vectorFree(&m->chunks[i].starts);
     }
 
-    // Parse the rules from the file
-    int ** rules = NULL;
-    int nRules = parseRules(fp, &rules);
+    free(m->chunks);
+    free(m);
+}
 
-    // Initialize the counters of the medians for part 1 and part 2
-    int count = 0,  count2 = 0;
+// Parses the rules and compiles them, only the matrix is kept, then reads the updates.
+// The updates are independent, so they're split at newlines and the chunks are read
+// in parallel, then checked the same way by the parts
+static void * parseManual(const inputFile * in) {
+    manual * m = calloc(1, sizeof(manual));
 
-    // Initialize the array to store the line
-    int * arr = NULL;
-    int n;
+    scanner s = inputScanner(in);
 
-    // While there are lines in the file
-    while ((n=parseLine(fp, &arr)) > 0) {
-        // If the line matches all the rules, it's a valid update
-        if (enforce(rules, arr, nRules, n)) {
-            // Add the median of the valid update to the count
-            count+= median(arr, n);
-        } else {
-            // Sort the invalid update using the rules
-            sort(arr, n, rules, nRules);
+    // Parse the rules from the file and compile them
+    vector rules = VECTOR(int32_t);
+    int err = parseRules(&s, &rules) || compileRules(&rules, &m->order);
+    vectorFree(&rules);
 
-            // Add the median of the sorted invalid update to the count
-            count2+= median(arr, n);
-        }
+    if (err) {
+        freeManual(m);
+        return NULL;
+    }
 
-        // Free the array to avoid memory leaks
-        free(arr);
+    m->parts = chunksFor(s.end - s.pos);
+    m->chunks = calloc(m->parts, sizeof(updateChunk));
+
+    scanner split[m->parts];
+    splitLines(s, m->parts, split);
+    for (int i = 0; i < m->parts; i++) {
+        m->chunks[i] = (updateChunk) { .s = split[i], .pages = VECTOR(int), .starts = VECTOR(size_t) };
     }
 
-    fclose(fp);
+    parallelFor(m->parts, m->parts, readChunk, m->chunks);
+
+    for (int i = 0; i < m->parts; i++) err |= m->chunks[i].err;
+    if (err) {
+        freeManual(m);
+        return NULL;
+    }
 
-    // Part 1: Find the sum of the medians of the valid updates
-    printf("Part 1: \n\tSum of medians of valid updates: %d\n", count);
+    return m;
+}
 
-    // Part 2: Find the sum of the medians of the invalid updates after sorting them
-    printf("Part 2: \n\tSum of medians of sorted invalid updates: %d\n", count2);
+// Sum of the medians of a chunk for a part, the rules and the updates are only read
+typedef struct {
+    const ruleMatrix * order;
+    const updateChunk * chunk;
+    int part;
+    uint64_t sum;
+} updateTask;
+
+// Checks every update of a chunk, part 1 adds up the medians of the valid ones
+// and part 2 the medians of the invalid ones once sorted
+static void checkChunk(int i, void * arg) {
+    updateTask * task = (updateTask *) arg + i;
+    const ruleMatrix * order = task->order;
+    const int * pages = task->chunk->pages.data;
+    const size_t * starts = task->chunk->starts.data;
+
+    // The same buffers are reused for every update
+    vector sorted = VECTOR(int);
+    uint64_t * seen = calloc(order->words + 1, sizeof(uint64_t));
+
+    for (size_t k = 0; k + 1 < task->chunk->starts.len; k++) {
+        const int * arr = pages + starts[k];
+        int n = starts[k + 1] - starts[k];
+
+        // Only the updates that match all the rules count for part 1, the others for part 2
+        int valid = enforce(order, seen, arr, n);
+        if (valid && task->part == 1) CHECKED_ADD(task->sum, (uint64_t) median(arr, n));
+        if (!valid && task->part == 2) CHECKED_ADD(task->sum, (uint64_t) repairedMedian(order, seen, &sorted, arr, n));
+    }
 
-    free(rules);
+    vectorFree(&sorted);
+    free(seen);
+}
 
-    return 0;
+// Adds up the medians of the updates for a part, the chunks are checked in parallel
+static uint64_t sumMedians(const manual * m, int part) {
+    updateTask * tasks = calloc(m->parts, sizeof(updateTask));
+    for (int i = 0; i < m->parts; i++) {
+        tasks[i] = (updateTask) { .order = &m->order, .chunk = &m->chunks[i], .part = part };
+    }
+
+    parallelFor(m->parts, m->parts, checkChunk, tasks);
+
+    // Add up the sums of every chunk
+    uint64_t sum = 0;
+    for (int i = 0; i < m->parts; i++) CHECKED_ADD(sum, tasks[i].sum);
+
+    free(tasks);
+    return sum;
+}
+
+// Part 1: Find the sum of the medians of the valid updates
+static uint64_t validMedians(void * puzzle) {
+    return sumMedians(puzzle, 1);
+}
+
+// Part 2: Find the sum of the medians of the invalid updates after sorting them
+static uint64_t sortedMedians(void * puzzle) {
+    return sumMedians(puzzle, 2);
 }
+
+const aocDay day05 = {
+    .number = 5,
+    .labels = { "Sum of medians of valid updates", "Sum of medians of sorted invalid updates" },
+    .parse = parseManual,
+    .part1 = validMedians,
+    .part2 = sortedMedians,
+    .release = freeManual,
+};
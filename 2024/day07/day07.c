@@ -1,42 +1,22 @@
 #include <stdio.h>
 #include <stdlib.h>
-#include <ctype.h>
 #include <string.h>
 #include <stdint.h>
 #include <math.h>
 
+#include "../common/day.h"
+#include "../common/checked.h"
+#include "../common/vector.h"
+#include "../common/arena.h"
+
 ////////////////////////////////////////////////////////////////
 // Advent of Code 2024 Day 7                                  //
 // Link: https://adventofcode.com/2024/day/7                  //
 ////////////////////////////////////////////////////////////////
 
-#define filename "day07input.txt"
-
-// Count the number of integers in a given string
-// Returns the number of integers found
-int countInts(char * str) {
-    int count = 0; // Initialize the count of integers to 0
-
-    int digPrev = 1; 
-    // Last digits signals whether the last character analyzed was a digit to check for the start of a new integer
-    // 0 = digit, 1 = non-digit. It's initialized to 1 to account strings starting with a digit
-    
-    int size = strlen(str); // Get the size of the string
-
-    for (int i = 0; i < size; i++) {
-        if (isdigit(str[i]) && digPrev) { // If the current character is a digit and the last one wasn't
-            count++; // Increment the count signaling a new integer was found
-        }
-
-        digPrev = isdigit(str[i]) ? 0 : 1; // Update the last digit variable
-    }
-
-    return count;
-}
-
 // Checks if a given array of integers can be combined in a way that equals a given
 // number using only additions and multiplications.
-int isSolvable2Ops(int * arr, int len, uint64_t sol) {
+static int isSolvable2Ops(int * arr, int len, uint64_t sol) {
     int count = 0;
     // Calculate the number of possible combinations of operators between the elements of the array.
     // len - 1 because between every two elements there is only one operator
@@ -64,7 +44,7 @@ int isSolvable2Ops(int * arr, int len, uint64_t sol) {
 
 // Converts a given number to its base-3 representation
 // and stores the result in the provided array
-void toBase3(int num, int len, int ** arr) {
+static void toBase3(int num, int len, int ** arr) {
     // Iterate over each position in the array
     for (int i = 0; i < len; i++) {
         // Divide by 3 and add the remainder to the array
@@ -74,7 +54,7 @@ void toBase3(int num, int len, int ** arr) {
 }
 
 // Calculate 3 raised to the power of n
-int pow3(int n) {
+static int pow3(int n) {
     int res = 1; // Initialize result to 1, as any number to the power of 0 is 1
 
     // Loop from 0 to n-1
@@ -88,7 +68,7 @@ int pow3(int n) {
 }
 
 // Concatenates n1 and n2 by shifting n1 to the left for every digit of n2
-uint64_t concat(uint64_t n1, int n2) {
+static uint64_t concat(uint64_t n1, int n2) {
     // Calculate the number of digits in n.
     int digits = log10(n2) + 1;
     
@@ -103,15 +83,17 @@ uint64_t concat(uint64_t n1, int n2) {
 
 // Checks if a given array of integers can be combined in a way that equals a given
 // number using only additions, multiplications and concatenation.
-int isSolvable3Ops(int * arr, int len, uint64_t sol) {
+static int isSolvable3Ops(int * arr, int len, uint64_t sol, arena * scratch) {
     int count = 0;
 
     // Calculate the number of possible combinations of operators between the elements of the array.
     //  len - 1 because between every two elements there is only one operator
     uint32_t chances = pow3(len - 1);
 
-    // Allocate an array to store the operators for each combination
-    int * ops = calloc(len - 1, sizeof(int));
+    // Take an array to store the operators for each combination from the arena,
+    // it's given back at once when the equation is checked
+    arenaMark mark = arenaSave(scratch);
+    int * ops = arenaCalloc(scratch, len - 1, sizeof(int));
 
     // Loop through each possible combination of the operators
     for (uint32_t i = 0; i < chances; i++) {
@@ -131,81 +113,115 @@ int isSolvable3Ops(int * arr, int len, uint64_t sol) {
             } else if (ops[j] == 1) {
                 total *= arr[j + 1];
             } else {
-                total *= lshift(arr[j + 1]);
-                total += arr[j + 1];
+                total = concat(total, arr[j + 1]);
             }
         }
         
-        // If the total equals the solution, return 1
-        if (total == sol) return 1;
+        // If the total equals the solution, give back the operators and return 1
+        if (total == sol) { arenaRestore(scratch, mark); return 1; }
     }
 
     // If no combination was found, return 0
+    arenaRestore(scratch, mark);
     return 0;
 }
 
 
 
-// Reads a file line by line, parses each line into two parts: a number and an array of numbers.
-// Then, it sums the number at the beginning of the line if the array of numbers can be combined 
-// to equal that value using only two or three operators (depending on the value of the part parameter).
-uint64_t parseFile(int part) {
-    uint64_t count = 0;
-        
-    // Open the file to read from
-    FILE * fp = fopen(filename, "r");
-    if (fp == NULL) {
-        printf("Error while opening file\n");
-        return 1;
-    }
+// The list of equations, each one is a test value and the numbers to combine.
+// The numbers of all the equations are stored one after the other, the
+// equation i goes from nums[starts[i]] to nums[starts[i + 1]]
+typedef struct {
+    vector sols;
+    vector nums;
+    vector starts;
+} equations;
 
-    char line[256];
+// Reads the input line by line, parses each line into two parts: a number and an array of numbers.
+static void * parseFile(const inputFile * in) {
+    equations * eq = malloc(sizeof(equations));
+    eq->sols = VECTOR(uint64_t);
+    eq->nums = VECTOR(int);
+    eq->starts = VECTOR(int);
+
+    scanner s = inputScanner(in);
+    lineView line;
+
+    *(int *) vectorPush(&eq->starts) = 0;
     
     // For each line in the file
-    while (fgets(line, sizeof(line), fp) != NULL) {
-        // Count the number of integers in the line and allocate an array to store them
-        int len = countInts(line) - 1;
-        int * tmp = calloc(len, sizeof(int));   
-        
+    while (nextLine(&s, &line)) {
         // Read the number at the beginning of the line
-        uint64_t sol;
-        sscanf(line, "%llu", &sol);
-
-        // Skip the colon and the space after it
-        char * ptr = line;
-        while (*ptr != ':') ptr++;
-        ptr++;
+        scanner ls = lineScanner(line);
+        int64_t sol, val;
+        if (!nextInt(&ls, &sol)) continue;
         
-        // For each number in the array
-        for (int i = 0; i < len; i++) {
-            // Read the number from the line
-            sscanf(ptr, "%d", &(tmp[i]));
-            
-            // Move the pointer past the number just read
-            ptr++;
-            while (*ptr != ' ') ptr++;
+        // Read every other number of the line
+        int len = 0;
+        while (nextInt(&ls, &val)) {
+            *(int *) vectorPush(&eq->nums) = val;
+            len++;
         }
 
+        // Skip the lines without numbers to combine
+        if (len < 1) continue;
+
+        *(uint64_t *) vectorPush(&eq->sols) = sol;
+        *(int *) vectorPush(&eq->starts) = eq->nums.len;
+    }
+
+    return eq;
+}
+
+// Sums the number at the beginning of the line if the array of numbers can be combined 
+// to equal that value using only two or three operators (depending on the value of the part parameter).
+static uint64_t sumSolvable(equations * eq, int part) {
+    uint64_t count = 0;
+    int * starts = eq->starts.data;
+    arena scratch = ARENA(1 << 12);
+
+    for (size_t i = 0; i < eq->sols.len; i++) {
+        int * nums = &VECTOR_AT(eq->nums, int, starts[i]);
+        int len = starts[i + 1] - starts[i];
+        uint64_t sol = VECTOR_AT(eq->sols, uint64_t, i);
+
         // Check if the array can be combined in a way that equals the number at the beginning of the line
         if (part == 1) {
-            if (isSolvable2Ops(tmp, len, sol)) count+= sol;
+            if (isSolvable2Ops(nums, len, sol)) CHECKED_ADD(count, sol);
         } else {
-            if (isSolvable3Ops(tmp, len, sol)) count+= sol;
+            if (isSolvable3Ops(nums, len, sol, &scratch)) CHECKED_ADD(count, sol);
         }
-
-        // Free the memory allocated for the array
-        free(tmp);
     }
 
+    arenaFree(&scratch);
     return count;
-    
 }
 
+// Part 1: Sum the test values of the equations solvable with (+, *)
+static uint64_t solvable2Ops(void * puzzle) {
+    return sumSolvable(puzzle, 1);
+}
 
+// Part 2: Sum the test values of the equations solvable with (+, *, ||)
+static uint64_t solvable3Ops(void * puzzle) {
+    return sumSolvable(puzzle, 2);
+}
 
-int main(void) {
-    printf("Part 1: \n\tNumber of solvable equations with operators (+, *): %llu\n", parseFile(1));
-    printf("Part 2: \n\tNumber of solvable equations with operators (+, *, ||): %llu\n", parseFile(2));
+// Free the memory of every equation
+static void freeEquations(void * puzzle) {
+    equations * eq = puzzle;
+    vectorFree(&eq->sols); vectorFree(&eq->nums); vectorFree(&eq->starts);
+    free(eq);
+}
 
-    return 0;
-}
\ No newline at end of file
+const aocDay day07 = {
+    .number = 7,
+    .labels = {
+        "Number of solvable equations with operators (+, *)",
+        "Number of solvable equations with operators (+, *, ||)",
+    },
+    .parse = parseFile,
+    .part1 = solvable2Ops,
+    .part2 = solvable3Ops,
+    .release = freeEquations,
+};
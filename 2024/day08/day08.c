@@ -4,18 +4,19 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "../common/day.h"
+#include "../common/grid.h"
+#include "../common/vector.h"
+
 ////////////////////////////////////////////////////////////////
 // Advent of Code 2024 Day 8                                  //
 // Link: https://adventofcode.com/2024/day/8                  //
 ////////////////////////////////////////////////////////////////
 
-#define filename "day08input.txt"
-
 #define CHAR_COUNT 62
-#define ANT_NUM 10
 
 // Maps character to index (0-61)
-int mapCharToIndex(char ch) {
+static int mapCharToIndex(char ch) {
     if (isupper(ch)) return ch - 'A';
     else if (islower(ch)) return (ch - 'a') + 26;
     else if (isdigit(ch)) return (ch - '0') + 52;
@@ -23,7 +24,7 @@ int mapCharToIndex(char ch) {
 }
 
 // Maps index (0-61) back to character
-char mapIndexToChar(int index) {
+static char mapIndexToChar(int index) {
     if (index < 26) return 'A' + index;
     else if (index < 52) return 'a' + (index - 26);
     else if (index < 62) return '0' + (index - 52);
@@ -39,84 +40,43 @@ typedef struct {
 // Frequency struct
 typedef struct {
     char freq;
-    int length;
-    point pos[ANT_NUM]; // Array of points, max length 10 is enough
+    vector pos; // Points of the antennae, a map can have any number of them
 } frequency;
 
-void fillMatrix(frequency matrix[CHAR_COUNT]) {
+static void fillMatrix(frequency matrix[CHAR_COUNT]) {
     // Iterate over each possible character index (0 to 61)
     for (int i = 0; i < CHAR_COUNT; i++) {
         // Initialize frequency struct for each character
-        matrix[i] = (frequency) {mapIndexToChar(i)};
+        matrix[i] = (frequency) {mapIndexToChar(i), VECTOR(point)};
     }
 }
 
-// Maps antennae to coordinates in the frequency matrix.
-void mapAntennae(frequency mat[CHAR_COUNT], int *rows, int *cols) {
-    // Open the file for reading
-    FILE *fp = fopen(filename, "r");
-    if (fp == NULL) {
-        printf("Error opening file.\n");
-        return;
-    }
+// Maps antennae to coordinates in the frequency matrix, returns 0 on success
+static int mapAntennae(const inputFile *in, frequency mat[CHAR_COUNT], int *rows, int *cols) {
+    gridView grid;
+    if (inputGrid(in, &grid)) return 1;
 
-    // Initialize the current position
-    int x = 0, y = 0;
+    // Iterate over each character of the map, x is the column and y the row
+    for (int y = 0; y < grid.rows; y++) {
+        const char *row = grid.data + (size_t) y * grid.stride;
 
-    // Iterate over each character in the file
-    char ch;
-    
-    while ((ch = fgetc(fp)) != EOF) {
-        // Map the character to an index (0 to 61)
-        int index = mapCharToIndex(ch);
-        // If the character is valid, store the position in the frequency matrix
-        if (index != -1) mat[index].pos[mat[index].length++] = (point) {x, y};
-
-        // Move to the next column
-        x++;
-
-        // If we've reached the end of a line, move to the next row
-        if (ch == '\n') {
-            x = 0;
-            y++;
+        for (int x = 0; x < grid.cols; x++) {
+            // Map the character to an index (0 to 61)
+            int index = mapCharToIndex(row[x]);
+            // If the character is valid, store the position in the frequency matrix
+            if (index != -1) *(point *) vectorPush(&mat[index].pos) = (point) {x, y};
         }
     }
 
-    // Close the file
-    fclose(fp);
-
     // Store the number of rows and columns
-    *rows = y + 1;
-    *cols = x;
-}
-
-// Boolean matrix
-typedef struct {
-    int rows;
-    int cols;
-    bool * mat; // Boolean matrix is stored as an array of bools to save space
-} boolMatrix;
-
-boolMatrix createBoolMatrix(int rows, int cols) {
-    // Allocate memory for the boolean matrix. 
-    // The matrix is represented as a 1D array of bools with a size equal to rows * cols.
-    bool * mat = calloc(rows * cols, sizeof(bool)); 
-
-    // Initialize each element in the matrix to false (0).
-    for (int i = 0; i < rows * cols; i++) {
-        mat[i] = false;
-    }
-
-    // Return a boolMatrix struct containing the number of rows, columns, and a pointer to the matrix.
-    return (boolMatrix) {rows, cols, mat};
-}
+    *rows = grid.rows;
+    *cols = grid.cols;
 
-void freeBoolMatrix(boolMatrix board) {
-    free(board.mat);
+    return 0;
 }
 
 // Function to check if a point is within the bounds of a matrix
-bool fitBounds(point a, int rows, int cols) {
+static bool fitBounds(point a, int rows, int cols) {
     // Check if the x-coordinate is less than 0 or greater than or equal to the number of columns
     if (a.x < 0 || a.x >= cols) return false;
 
@@ -129,7 +89,7 @@ bool fitBounds(point a, int rows, int cols) {
 
 // Function to mark the points that makes an antinode for part1, that means they're spaced
 // from an antenna and twice the distance from another antenna with the same frequency
-void makepoint1(point a, point b, boolMatrix board) {
+static void makepoint1(point a, point b, grid * board) {
     // Calculate the difference in x and y coordinates between a and b.
     // This will be used to calculate the coordinates of the point directly above or below a and b.
     // The differents uses the sign to determine the direction.
@@ -141,19 +101,19 @@ void makepoint1(point a, point b, boolMatrix board) {
     point preB = {b.x - dx, b.y - dy};
 
     // If the point directly above or below a is within the bounds of the matrix, mark it as visible.
-    if (fitBounds(preA, board.rows, board.cols)) {
-        board.mat[preA.y * board.cols + preA.x] = true;
+    if (fitBounds(preA, board->rows, board->cols)) {
+        GRID_AT(*board, preA.y, preA.x) = '#';
     };
     
     // If the point directly above or below b is within the bounds of the matrix, mark it as visible.
-    if (fitBounds(preB, board.rows, board.cols)) {
-        board.mat[preB.y * board.cols + preB.x] = true;
+    if (fitBounds(preB, board->rows, board->cols)) {
+        GRID_AT(*board, preB.y, preB.x) = '#';
     };
 }
 
 // Function to mark the points that makes an antinode for part2, that means they're on the same line
 // as two antennae with the same frequency and they are x times their distance apart from one of the antennae
-void makepoint2(point a, point b, boolMatrix board) {
+static void makepoint2(point a, point b, grid * board) {
     // Calculate the difference in x and y coordinates between a and b.
     // This will be used to calculate the coordinates of the point directly above or below a and b.
     // The differents uses the sign to determine the direction.
@@ -171,71 +131,107 @@ void makepoint2(point a, point b, boolMatrix board) {
         point preB = {b.x - (dx * i), b.y - (dy * i)};
 
         // Check if the points are within the bounds of the matrix
-        fitA = fitBounds(preA, board.rows, board.cols);
-        fitB = fitBounds(preB, board.rows, board.cols);
+        fitA = fitBounds(preA, board->rows, board->cols);
+        fitB = fitBounds(preB, board->rows, board->cols);
 
         // If the point is within the bounds of the matrix, mark it as visible
         if (fitA) {
-            board.mat[preA.y * board.cols + preA.x] = true;
+            GRID_AT(*board, preA.y, preA.x) = '#';
         };
     
         // If the point is within the bounds of the matrix, mark it as visible
         if (fitB) {
-            board.mat[preB.y * board.cols + preB.x] = true;
+            GRID_AT(*board, preB.y, preB.x) = '#';
         };
     }
 }
 
 // Count the number of points in a given matrix that make an antinode
-int countpoints(frequency mat[CHAR_COUNT], int rows, int cols, int part) {
-    // Create a boolean matrix to store the points that satisfy the conditions
-    boolMatrix board = createBoolMatrix(rows, cols);
+static uint64_t countpoints(frequency mat[CHAR_COUNT], int rows, int cols, int part) {
+    // Create a grid to mark the points that satisfy the conditions
+    grid board;
+    if (gridMake(&board, rows, cols, 0, '.')) return 0;
 
     // Iterate over each frequency in the matrix
     for (int i = 0; i < CHAR_COUNT; i++) {
         // Iterate over each position in the frequency
-        for (int j = 0; j < mat[i].length; j++) {
+        const point * pos = mat[i].pos.data;
+        int length = mat[i].pos.len;
+
+        for (int j = 0; j < length; j++) {
             // Iterate over each other position in the frequency after the current one so
             // each pair of positions is checked only once
-            for (int k = j + 1; k < mat[i].length; k++) {
+            for (int k = j + 1; k < length; k++) {
                 // Check the antinodes using the rules for each part
                 if (part == 1) {
-                    makepoint1(mat[i].pos[j], mat[i].pos[k], board);
+                    makepoint1(pos[j], pos[k], &board);
                 } else if (part == 2) {
-                    makepoint2(mat[i].pos[j], mat[i].pos[k], board);
+                    makepoint2(pos[j], pos[k], &board);
                 }
             }
         }
     }
 
     // Count the number of points that satisfy the conditions
-    int count = 0;
-    for (int i = 0; i < rows * cols; i++) {
-        if (board.mat[i]) count++;
+    // Without a border the rows are contiguous and the grid is a single run of cells
+    uint64_t count = 0;
+    for (size_t i = 0; i < (size_t) rows * cols; i++) {
+        if (board.cells[i] == '#') count++;
     }
 
-    // Free the memory allocated for the boolean matrix
-    free(board.mat);
+    // Free the memory allocated for the grid
+    gridFree(&board);
 
     return count;
 }
-int main() {
-    // Declare variables to store the number of rows and columns
-    int rows, cols;
-
-    // Declare a frequency array to hold the frequency data for each character
+// The antennae of the city grouped by frequency
+typedef struct {
+    int rows;
+    int cols;
     frequency matrix[CHAR_COUNT];
+} city;
+
+// Free the memory of the city
+static void freeCity(void * puzzle) {
+    city * c = puzzle;
+    for (int i = 0; i < CHAR_COUNT; i++) vectorFree(&c->matrix[i].pos);
+    free(c);
+}
+
+// Maps the antennae of the input
+static void * parseCity(const inputFile * in) {
+    city * c = calloc(1, sizeof(city));
 
     // Initialize the frequency matrix with the corresponding character for each index
-    fillMatrix(matrix);
+    fillMatrix(c->matrix);
 
     // Map the antennae positions from the input file to the frequency matrix
     // and store the number of rows and columns in the provided variables
-    mapAntennae(matrix, &rows, &cols);
+    if (mapAntennae(in, c->matrix, &c->rows, &c->cols)) { freeCity(c); return NULL; }
 
-    printf("Part 1:\n\tNumber of antinodes that are distant double from an antenna than another of the same frequency: %d\n", countpoints(matrix, rows, cols, 1));
-    printf("Part 2:\n\tNumber of antinodes that are on the same line as two antennae with the same frequency: %d\n", countpoints(matrix, rows, cols, 2));
+    return c;
+}
 
-    // Return 0 to indicate successful execution
-    return 0;
+// Part 1: Count the antinodes that are distant double from an antenna than another of the same frequency
+static uint64_t antinodes(void * puzzle) {
+    city * c = puzzle;
+    return countpoints(c->matrix, c->rows, c->cols, 1);
 }
+
+// Part 2: Count the antinodes that are on the same line as two antennae with the same frequency
+static uint64_t resonantAntinodes(void * puzzle) {
+    city * c = puzzle;
+    return countpoints(c->matrix, c->rows, c->cols, 2);
+}
+
+const aocDay day08 = {
+    .number = 8,
+    .labels = {
+        "Number of antinodes that are distant double from an antenna than another of the same frequency",
+        "Number of antinodes that are on the same line as two antennae with the same frequency",
+    },
+    .parse = parseCity,
+    .part1 = antinodes,
+    .part2 = resonantAntinodes,
+    .release = freeCity,
+};
@@ -4,55 +4,27 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "../common/day.h"
+#include "../common/checked.h"
+
 ////////////////////////////////////////////////////////////////
 // Advent of Code 2024 Day 9                                  //
 // Link: https://adventofcode.com/2024/day/9                  //
 ////////////////////////////////////////////////////////////////
 
-#define filename "day09input.txt"
-
-// Reads the contents of a file in a passed array and returns the number of bytes read.
-int readFile(char ** buffer) {
-    FILE * fp = fopen(filename, "rb");
-    if (fp == NULL) {
-        printf("Error while opening file\n");
-        return -1;
-    }
-
-    // Get the size of the file by seeking to the end of the file and calculating the offset
-    fseek(fp, 0, SEEK_END);
-    size_t size = ftell(fp);
-
-    // Reset the file pointer to the beginning of the file
-    rewind(fp);
-
-    // Allocate memory to store the contents of the file
-    *buffer = malloc(size + 1);
-
-    // Read the contents of the file into the buffer
-    fread(*buffer, 1, size, fp);
-
-    // Add a null character at the end of the buffer so that it can be used as a string
-    (*buffer)[size] = '\0';
-
-    fclose(fp);
-
-    return size;
-}
-
 // Calculate the new size of the disk by summing up the length of the commands
-int getNewSize(char * buffer, int size) {
+static int getNewSize(lineView ln) {
     int new_size = 0;
     
-    // Iterate through the buffer until a newline character is found
-    for (int i = 0; i < size; i++) {
-        // If a newline character is found, break out of the loop as the input is a oneliner
-        if (buffer[i] == '\n') break;
+    // Iterate through the line, the input is a oneliner
+    for (size_t i = 0; i < ln.len; i++) {
+        // Skip anything that isn't a digit, like a stray carriage return
+        if (!isdigit((unsigned char) ln.ptr[i])) continue;
         
         // Add the value of the current character to the new size as the digit could either mean x numbers or x spaces
         // The value of the character is calculated by subtracting the ASCII value of '0' from the character
         // This is because the characters in the buffer are the ASCII representations of the numbers
-        new_size += (int) buffer[i] - '0';
+        new_size += (int) ln.ptr[i] - '0';
     }
     
     return new_size;
@@ -61,30 +33,32 @@ int getNewSize(char * buffer, int size) {
 //Reads the contents of the file into a buffer and then processes the commands in the buffer to create a disk.
 // The disk is represented as a 1D array of integers, spaces are represented as -1 and numbers are repsented
 // by their id
-int * makeDisk(int * newsize) {
-    // Read the contents of the file into a buffer
-    char * buffer;
-    int size = readFile(&buffer);
+static int * makeDisk(const inputFile * in, int * newsize) {
+    // Read the commands from the first line of the input, without its line ending
+    scanner s = inputScanner(in);
+    lineView ln = { NULL, 0 };
+    nextLine(&s, &ln);
 
     // Calculate the new size of the disk
-    *newsize = getNewSize(buffer, size);
+    *newsize = getNewSize(ln);
 
     // Allocate memory to store the disk
     int * disk = calloc(*newsize, sizeof(int));
 
-    // Initialize variables to keep track of the current position in the disk and the current id
-    int id = 0, j = 0;
+    // Initialize variables to keep track of the current position in the disk, the current id
+    // and the number of commands read, which tells files and spaces apart
+    int id = 0, j = 0, commands = 0;
 
-    // Iterate through the buffer
-    for (int i = 0; i < size; i++) {
-        // If a newline character is found, break out of the loop as the input is a oneliner
-        if (buffer[i] == '\n' || buffer[i] == '\0') break;
+    // Iterate through the line
+    for (size_t i = 0; i < ln.len; i++) {
+        // Skip the same characters as getNewSize so the disk is filled exactly
+        if (!isdigit((unsigned char) ln.ptr[i])) continue;
 
         // Get the number of positions to fill from the buffer
-        int count = buffer[i] - '0';
+        int count = ln.ptr[i] - '0';
 
         // Get the value to fill the positions with from the buffer
-        int val = (i % 2 == 0) ? id++ : -1;
+        int val = (commands++ % 2 == 0) ? id++ : -1;
 
         // Fill the positions in the disk with the value
         // Memset fills count * sizeof(int) bytes with the value val starting from the position j
@@ -95,9 +69,6 @@ int * makeDisk(int * newsize) {
         //memset(disk + j, val, count * sizeof(int));
     }
 
-    // Free the memory allocated for the buffer
-    free(buffer);
-
     // Return the pointer to the first element of the disk array
     return disk;
 }
@@ -105,7 +76,7 @@ int * makeDisk(int * newsize) {
 
 // This function takes a disk represented as a 1D array of integers and compacts it by shifting all integers from right
 // to the first available space from the left
-void compactDisk(int * disk, int new_size) {
+static void compactDisk(int * disk, int new_size) {
     // It uses two pointers to keep track of the current position in the disk
     // one for reading and one for writing
     int write = 0, read = new_size - 1;
@@ -127,7 +98,7 @@ void compactDisk(int * disk, int new_size) {
 
 
 // This function calculates a checksum for a given disk.
-uint64_t checkSum(int * disk, int new_size) {
+static uint64_t checkSum(int * disk, int new_size) {
     uint64_t sum = 0;
 
     // Loop through each element in the disk
@@ -136,7 +107,9 @@ uint64_t checkSum(int * disk, int new_size) {
         if (disk[i] == -1) continue;
         
         // Multiply the id of the current element by its index and add it to the sum
-        sum += disk[i] * i;
+        uint64_t product;
+        CHECKED_MUL(product, (uint64_t) disk[i], (uint64_t) i);
+        CHECKED_ADD(sum, product);
     }
 
     // Return the checksum
@@ -145,7 +118,7 @@ uint64_t checkSum(int * disk, int new_size) {
 
 
 // This function calculates the number of consecutive numbers of the same id from right to left starting from a given position
-int countNums(int * disk, int start) {
+static int countNums(int * disk, int start) {
     int count = 0;
     int num = disk[start];
 
@@ -161,7 +134,7 @@ int countNums(int * disk, int start) {
 }
 
 // Finds the first gap from the left that fits the given suze
-int findGap(int * disk, int start, int size) {
+static int findGap(int * disk, int start, int size) {
     // Initialize a counter for tracking the current gap size
     int gap = 0;
 
@@ -181,7 +154,7 @@ int findGap(int * disk, int start, int size) {
 
 // Compacts the disk by moving all the blocks of the same id to the leftmost part of the disk
 // in the order of their id.
-void compactDiskByFile (int * disk, int size) {
+static void compactDiskByFile (int * disk, int size) {
     // Initialize two pointers, write and read.
     int write = 0, read = size - 1;
     
@@ -217,25 +190,55 @@ void compactDiskByFile (int * disk, int size) {
 }
 
 
-int main() {
-    // Read the disk from the file and allocate memory for it
+// The disk as it's laid out before compacting it
+typedef struct {
+    int * disk;
     int size;
-    int * disk = makeDisk(&size);
+} diskMap;
+
+// Reads the disk from the file and allocate memory for it
+static void * parseDisk(const inputFile * in) {
+    diskMap * d = calloc(1, sizeof(diskMap));
+    d->disk = makeDisk(in, &d->size);
+
+    return d;
+}
 
-    // Create a copy of the disk for part 2
-    int * disk2 = calloc(size, sizeof(int));
-    memcpy(disk2, disk, size * sizeof(int));
+// Compacts a copy of the disk using one of the two strategies and returns its checksum
+static uint64_t compactCopy(diskMap * d, void (*compact)(int *, int)) {
+    // Create a copy of the disk so the original layout is kept
+    int * disk = calloc(d->size, sizeof(int));
+    memcpy(disk, d->disk, d->size * sizeof(int));
 
-    // Execute part 1
-    compactDisk(disk, size);
-    printf("Part 1: \n\tCheck sum: %llu\n", checkSum(disk, size));
+    compact(disk, d->size);
+    uint64_t sum = checkSum(disk, d->size);
     free(disk);
 
-    // Execute part 2
-    compactDiskByFile(disk2, size);
-    printf("Part 2: \n\tCheck sum: %llu\n", checkSum(disk2, size));
-    free(disk2);
+    return sum;
+}
 
-    // Return 0 to indicate successful execution
-    return 0;
+// Part 1: Moves the blocks one at a time
+static uint64_t checkSumBlocks(void * puzzle) {
+    return compactCopy(puzzle, compactDisk);
 }
+
+// Part 2: Moves whole files
+static uint64_t checkSumFiles(void * puzzle) {
+    return compactCopy(puzzle, compactDiskByFile);
+}
+
+// Free the memory allocated for the disk
+static void freeDisk(void * puzzle) {
+    diskMap * d = puzzle;
+    free(d->disk);
+    free(d);
+}
+
+const aocDay day09 = {
+    .number = 9,
+    .labels = { "Check sum", "Check sum" },
+    .parse = parseDisk,
+    .part1 = checkSumBlocks,
+    .part2 = checkSumFiles,
+    .release = freeDisk,
+};
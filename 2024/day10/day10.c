@@ -2,226 +2,164 @@
 #include <stdlib.h>
 #include <stdint.h>
 
+#include "../common/day.h"
+#include "../common/checked.h"
+#include "../common/grid.h"
+
 ////////////////////////////////////////////////////////////////
 // Advent of Code 2024 Day 10                                 //
 // Link: https://adventofcode.com/2024/day/10                 //
 ////////////////////////////////////////////////////////////////
 
-#define filename "day10input.txt"
-
-// Define macro to switch position between 2d array and 1d array
-#define ARR_POS(x, y, cols) x + y * cols // 2d to 1d
-#define CORDS(x, cols) x % cols, x / cols // 1d to 2d
-
-// Define a struct to represent a hiketrail
+// Define a struct to represent a hiketrail, the heights are kept as the characters
+// '0' to '9' inside a border of '.' so a trail stops at the edge without checking the bounds
 typedef struct {
-    uint8_t rows;
-    uint8_t cols;
-    uint8_t * mat; // Using a 1d array to save space and improve performance 
+    grid g;
+    ptrdiff_t steps[4]; // Offset of a step right, left, down and up
 } hiketrail;
 
-hiketrail readFile(void) {
-    FILE * fp = fopen(filename, "r");
-    if (fp == NULL) {
-        printf("Error while opening file\n");
-        // If the file can't be opened, exit the program
-        exit(1);
-    }
-
-    // Read the first line of the file, and store the number of columns
-    char ch;
-    int cols = 0;
-    while ((ch = fgetc(fp)) != '\n') cols++;
-
-    // Move the file pointer to the end of the file
-    fseek(fp, 0, SEEK_END);
-
-    // Calculate the number of rows
-    int rows = (ftell(fp) - 1) / (cols + 1);
-    // - 1 to account for the offset
-    // + 1 to account for the newline character
+// Reads the map from the input, returns NULL if the input isn't a grid
+static void * readFile(const inputFile * in) {
+    hiketrail * trail = malloc(sizeof(hiketrail));
+    if (gridFromInput(&trail->g, in, 1, '.')) { free(trail); return NULL; }
 
-    // Reset the file pointer to the beginning of the file
-    fseek(fp, 0, SEEK_SET);
+    trail->steps[0] = GRID_STEP(trail->g, 0, 1);
+    trail->steps[1] = GRID_STEP(trail->g, 0, -1);
+    trail->steps[2] = GRID_STEP(trail->g, 1, 0);
+    trail->steps[3] = GRID_STEP(trail->g, -1, 0);
 
-    // Allocate memory for the matrix as an array of 8 bit unsigned integers
-    // to save space
-    uint8_t * mat = calloc(rows * cols, sizeof(uint8_t));
-
-    // Read the matrix character by character
-    int i = 0;
-    while ((ch = fgetc(fp)) != EOF) {
-        if (ch == '\n') continue;
-        // Store the value as an 8 bit unsigned integer
-        mat[i++] = ch - '0';
-    }
-
-    // Close the file
-    fclose(fp);
-
-    // Return the struct containing the matrix, rows and columns
-    return (hiketrail) { rows, cols, mat };
+    return trail;
 }
 
 
-// Struct to store the coordinates of the destinations
-// using a 16 bit integer as it's uknown how many destinations there will be
-// 65535 should be more than enough while 256 could be too small
+// Struct to remember the destinations reached from the current starting point.
+// Every cell stores the id of the last start that reached it, so the marks
+// don't need to be cleared between two starting points
 typedef struct {
-    uint16_t len;
-    uint16_t *pos;
+    uint32_t id;
+    uint32_t *stamp; // One entry per cell of the grid, border included
 } destinations;
 
-// Add a coordinate to the destinations array if it's not already there.
-void addCords(destinations dests, uint16_t x) {
-    // Iterate over the array of coordinates and check if the coordinate 
-    for (uint16_t i = 0; i < dests.len; i++) {
-        // If the coordinate is already in the array, return. Using +1 as 0 is the empty space
-        if (dests.pos[i] == x + 1) return;
-        else if (dests.pos[i] == 0) {
-        // Insert at the first empty slot
-            dests.pos[i] = x + 1;
-            return;
-        };
-    }
-}
-
-// Recursively make a trail from a given coordinate and add the coordinates to the destinations array
-void makeTrail(hiketrail trail, uint8_t x, uint8_t y, destinations dests) {
-    // Get the value at the current coordinate
-    uint8_t val = trail.mat[ARR_POS(x, y, trail.cols)];
-    
+// Recursively make a trail from a given cell and return the number of new destinations reached
+static uint64_t makeTrail(const hiketrail * trail, const char * cell, destinations * dests) {
     // Base case if end of trail is reached
-    if (val == 9) {
-        // Add the coordinate to the destinations array
-        addCords(dests, (uint16_t) ARR_POS(x, y, trail.cols));
-        return;
-    };
+    if (*cell == '9') {
+        // Count the destination only the first time it's reached from this start
+        uint32_t * seen = &dests->stamp[cell - trail->g.block];
+        if (*seen == dests->id) return 0;
 
-    // Get the next coordinates as signed ints to account for negative coordinates
-    // that are out of bounds
-    int16_t next[4][2] = {
-        { x + 1, y },
-        { x - 1, y },
-        { x, y + 1 },
-        { x, y - 1 }
+        *seen = dests->id;
+        return 1;
     };
 
-    // Iterate over the array of next coordinates
-    for (uint8_t i = 0; i < 4; i++) {
-        // Check if the next coordinate is out of bounds
-        if (next[i][0] < 0 || next[i][0] >= trail.cols) continue;
-        if (next[i][1] < 0 || next[i][1] >= trail.rows) continue;
+    uint64_t count = 0;
 
-        // Check if the next coordinate succesfully continues the trail
-        if (trail.mat[(uint16_t) ARR_POS(next[i][0], next[i][1], trail.cols)] != val + 1) continue;
+    // Iterate over the four neighbours, the border never continues a trail
+    for (int i = 0; i < 4; i++) {
+        const char * next = cell + trail->steps[i];
 
-        // Recursively make a trail to the next coordinate
-        makeTrail(trail, (uint8_t) next[i][0], (uint8_t) next[i][1], dests);
-    }
-}
+        // Check if the next cell succesfully continues the trail
+        if (*next != *cell + 1) continue;
 
-// Make a trail from a given coordinate and return the number of destinations
-uint16_t startTrail(hiketrail trail, uint16_t start, destinations dests) {
-    // Reset the destinations array
-    for (uint16_t i = 0; i < dests.len; i++) {
-        dests.pos[i] = 0;
-    }
-
-    makeTrail(trail, CORDS(start, trail.cols), dests);
-
-    // Count the number of destinations
-    uint16_t count = 0;
-    for (uint16_t i = 0; i < dests.len; i++) {
-        if (dests.pos[i] == 0) break;
-        count++;
+        // Recursively make a trail to the next cell
+        count += makeTrail(trail, next, dests);
     }
 
     return count;
 }
 
 // Count the sum of the number of destinations reachable from each starting point
-uint16_t countTrails(hiketrail trail) {
-    uint16_t des_count = 0;
+static uint64_t countTrails(const hiketrail * trail) {
+    const grid * g = &trail->g;
 
-    // Count the number of destinations
-    for (uint16_t i = 0; i < trail.rows * trail.cols; i++) {
-        if (trail.mat[i] == 9) des_count++;
-    }
-
-    // Allocate memory for the destinations array and initialize it in the struct
-    destinations dests = (destinations) {des_count, calloc(des_count, sizeof(uint16_t))};
+    // Allocate the marks of the destinations for the whole grid, 0 is no start
+    size_t cells = (size_t) (g->rows + 2 * g->pad) * g->stride;
+    destinations dests = (destinations) {0, calloc(cells, sizeof(uint32_t))};
 
     // For every character in the trail
-    uint16_t count = 0;
-    for (uint16_t i = 0; i < trail.rows * trail.cols; i++) {
-        // If it's a zero, start a new trail
-        if (trail.mat[i] == 0) {
-            count += startTrail(trail, i, dests);
-        };
+    uint64_t count = 0;
+    for (int r = 0; r < g->rows; r++) {
+        const char * row = &GRID_AT(*g, r, 0);
+
+        for (int c = 0; c < g->cols; c++) {
+            // If it's a zero, start a new trail
+            if (row[c] == '0') {
+                dests.id++;
+                CHECKED_ADD(count, makeTrail(trail, &row[c], &dests));
+            };
+        }
     }
 
-    free(dests.pos);
+    free(dests.stamp);
 
     return count;
 }
 
-// Recursively make a trail from a given coordinate
-uint16_t makeTrail2(hiketrail trail, uint8_t x, uint8_t y) {
-    // Get the value at the current coordinate
-    uint8_t val = trail.mat[ARR_POS(x, y, trail.cols)];
-
+// Recursively make a trail from a given cell
+static uint64_t makeTrail2(const hiketrail * trail, const char * cell) {
     // Base case if end of trail is reached
-    if (val == 9) return 1;
+    if (*cell == '9') return 1;
 
     // Count is the number of trails that can be completed
-    // that include the current coordinate
-    uint16_t count = 0;
-
-    // Get the next coordinates as signed ints to account for negative coordinates
-    int16_t next[4][2] = {
-        { x + 1, y },
-        { x - 1, y },
-        { x, y + 1 },
-        { x, y - 1 }
-    };
+    // that include the current cell
+    uint64_t count = 0;
 
-    // Iterate over the array of next coordinates
-    for (uint8_t i = 0; i < 4; i++) {
-        // Check if the next coordinate is out of bounds
-        if (next[i][0] < 0 || next[i][0] >= trail.cols) continue;
-        if (next[i][1] < 0 || next[i][1] >= trail.rows) continue;
+    // Iterate over the four neighbours, the border never continues a trail
+    for (int i = 0; i < 4; i++) {
+        const char * next = cell + trail->steps[i];
 
-        // Check if the next coordinate succesfully continues the trail
-        if (trail.mat[(uint16_t) ARR_POS(next[i][0], next[i][1], trail.cols)] != val + 1) continue;
+        // Check if the next cell succesfully continues the trail
+        if (*next != *cell + 1) continue;
 
-        // Add the number of possible trails that include both the current and next coordinate
-        count += makeTrail2(trail, (uint8_t) next[i][0], (uint8_t) next[i][1]);
+        // Add the number of possible trails that include both the current and next cell
+        CHECKED_ADD(count, makeTrail2(trail, next));
     }
 
     return count;
 }
 
 // Count the number of possible trails
-uint16_t countTrails2(hiketrail trail) {
-    uint16_t count = 0;
+static uint64_t countTrails2(const hiketrail * trail) {
+    const grid * g = &trail->g;
+    uint64_t count = 0;
 
     // For every character in the trail
-    for (uint16_t i = 0; i < trail.rows * trail.cols; i++) {
-        // If it's a zero, start a new trail
-        if (trail.mat[i] == 0) {
-            count += makeTrail2(trail, CORDS(i, trail.cols));
-        };
+    for (int r = 0; r < g->rows; r++) {
+        const char * row = &GRID_AT(*g, r, 0);
+
+        for (int c = 0; c < g->cols; c++) {
+            // If it's a zero, start a new trail
+            if (row[c] == '0') {
+                CHECKED_ADD(count, makeTrail2(trail, &row[c]));
+            };
+        }
     }
 
     return count;
 }
 
-int main(void) {
-    hiketrail trail = readFile();
+// Part 1: Sum of the number of destinations from each low point
+static uint64_t destinationsSum(void * puzzle) {
+    return countTrails(puzzle);
+}
 
-    printf("Part 1:\n\tSum of the number of destinations from each low point: %u\n", countTrails(trail));
-    printf("Part 1:\n\tNumber of possible trails: %u\n", countTrails2(trail));
+// Part 2: Number of possible trails
+static uint64_t trailsCount(void * puzzle) {
+    return countTrails2(puzzle);
+}
 
-    return 0;
+// Free the memory allocated for the map
+static void freeTrail(void * puzzle) {
+    hiketrail * trail = puzzle;
+    gridFree(&trail->g);
+    free(trail);
 }
+
+const aocDay day10 = {
+    .number = 10,
+    .labels = { "Sum of the number of destinations from each low point", "Number of possible trails" },
+    .parse = readFile,
+    .part1 = destinationsSum,
+    .part2 = trailsCount,
+    .release = freeTrail,
+};
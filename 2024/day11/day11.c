@@ -3,13 +3,15 @@
 #include <string.h>
 #include <stdint.h>
 
+#include "../common/day.h"
+#include "../common/checked.h"
+#include "../common/arena.h"
+
 ////////////////////////////////////////////////////////////////
 // Advent of Code 2024 Day 11                                 //
 // Link: https://adventofcode.com/2024/day/11                 //
 ////////////////////////////////////////////////////////////////
 
-#define filename "day11input.txt"
-
 // Define a struct to represent a stone with a value and quantity
 typedef struct stone {
     uint64_t val; 
@@ -18,13 +20,10 @@ typedef struct stone {
 } stone;
 
 // Function to create a new stone node
-stone *makeNode(uint64_t val, uint64_t quantity) {
+// The stones of a list are taken from an arena and given back all together
+static stone *makeNode(arena *mem, uint64_t val, uint64_t quantity) {
     // Allocate memory for a new stone
-    stone *node = malloc(sizeof(stone));
-    if (node == NULL) {
-        fprintf(stderr, "Memory allocation failed in makeNode.\n");
-        exit(EXIT_FAILURE); // Exit the program if memory allocation fails
-    }
+    stone *node = arenaAlloc(mem, sizeof(stone));
 
     // Initialize the stone with the provided value and quantity
     node->val = val;
@@ -36,29 +35,29 @@ stone *makeNode(uint64_t val, uint64_t quantity) {
 }
 
 // Insert a new stone at the head of the list
-void insOnHead(stone **head, stone *new) {
+static void insOnHead(stone **head, stone *new) {
     new->next = *head;
     *head = new;
 }
 
 // Insert a new stone after a given stone node
-void insAfter(stone *node, stone *new) {
+static void insAfter(stone *node, stone *new) {
     new->next = node->next;
     node->next = new;
 }
 
 // Insert a stone in a sorted order based on its value
-void insInOrder(stone **head, uint64_t val, uint64_t quantity) {
+static void insInOrder(arena *mem, stone **head, uint64_t val, uint64_t quantity) {
     // If the list is empty, insert at the head
     if (*head == NULL) {
-        insOnHead(head, makeNode(val, quantity));
+        insOnHead(head, makeNode(mem, val, quantity));
         return;
     }
 
     // If the list has only one stone and it's greater than the new one
     // then insert it as the head to maintain the sorted order
     if ((*head)->next == NULL && (*head)->val > val) {
-        insOnHead(head, makeNode(val, quantity));
+        insOnHead(head, makeNode(mem, val, quantity));
         return;
     }
 
@@ -70,55 +69,55 @@ void insInOrder(stone **head, uint64_t val, uint64_t quantity) {
 
     // If a stone with the same value exists, update the quantity
     if (node->next != NULL && node->next->val == val) {
-        node->next->quantity += quantity;
+        CHECKED_ADD(node->next->quantity, quantity);
         return;
     }
 
     // Insert the new stone at the correct position
-    insAfter(node, makeNode(val, quantity));
+    insAfter(node, makeNode(mem, val, quantity));
 }
 
 // Count the total quantity of stones in the list
-uint64_t countStones(stone *head) {
+static uint64_t countStones(stone *head) {
     uint64_t count = 0;
     // For each stone in the list
     while (head != NULL) {
-        count += head->quantity; // Add the quantity of current stone
+        CHECKED_ADD(count, head->quantity); // Add the quantity of current stone
         head = head->next;
     }
     return count; 
 }
 
-// Free the memory allocated for the list of stones
-void freeStones(stone *head) {
-    stone *temp;
+// Copy a list of stones keeping its order
+static stone *copyStones(arena *mem, stone *head) {
+    stone *copy = NULL, **tail = &copy;
+
+    // Append a copy of each stone at the end of the new list
     while (head != NULL) {
-        temp = head;     // Store current head
-        head = head->next; // Move to next stone
-        free(temp);      // Free the current stone
+        *tail = makeNode(mem, head->val, head->quantity);
+        tail = &(*tail)->next;
+        head = head->next;
     }
+
+    return copy;
 }
 
 // Parse stones from a file and insert them into a linked list
-stone *parseFile() {
-    FILE *fp = fopen(filename, "r");
-    if (fp == NULL) return NULL;
-
+static stone *parseFile(arena *mem, const inputFile *in) {
     stone *head = NULL; // Initialize the head of the list
 
-    uint64_t val;
+    int64_t val;
+    scanner s = inputScanner(in);
     // Read values from the file and insert into the list
-    while (fscanf(fp, "%llu", &val) == 1) {
-        insInOrder(&head, val, 1);
+    while (nextInt(&s, &val)) {
+        insInOrder(mem, &head, val, 1);
     };
 
-    fclose(fp); // Close the file
-
     return head; // Return the head of the list
 }
 
 // Count the number of digits in a number
-uint8_t countDigits(uint64_t num) {
+static uint8_t countDigits(uint64_t num) {
     uint8_t count = 0;
 
     // Keep dividing the number by 10 until it becomes 0, the number of digits is 
@@ -131,7 +130,7 @@ uint8_t countDigits(uint64_t num) {
 }
 
 // Split a number into two parts
-void splitNum(uint64_t num, uint64_t *left, uint64_t *right) {
+static void splitNum(uint64_t num, uint64_t *left, uint64_t *right) {
     uint8_t digits = countDigits(num) / 2; // Calculate the number of digits and divide by 2
 
     uint64_t div = 1;
@@ -145,15 +144,17 @@ void splitNum(uint64_t num, uint64_t *left, uint64_t *right) {
 
 // Process a stone and add stones with the appropriate values
 // to the new list
-void blinkStone(stone *st, stone **new) {
+static void blinkStone(arena *mem, stone *st, stone **new) {
     // If value is 0, add stones of value 1 and the same quantity
     if (st->val == 0) {
-        insInOrder(new, 1, st->quantity);
+        insInOrder(mem, new, 1, st->quantity);
         return;
     }
     // If the number of digits is odd, add stone with value multiplied by 2024 and the same quantity
     else if (countDigits(st->val) % 2 != 0) {
-        insInOrder(new, st->val * 2024, st->quantity);
+        uint64_t val;
+        CHECKED_MUL(val, st->val, (uint64_t) 2024);
+        insInOrder(mem, new, val, st->quantity);
         return;
     }
 
@@ -161,12 +162,14 @@ void blinkStone(stone *st, stone **new) {
     splitNum(st->val, &left, &right); // Split the stone value
 
     // Insert the left and right parts into the new list
-    insInOrder(new, left, st->quantity);
-    insInOrder(new, right, st->quantity);
+    insInOrder(mem, new, left, st->quantity);
+    insInOrder(mem, new, right, st->quantity);
 }
 
 // Perform a series of blinks on the stone list
-uint64_t blink(stone **head, uint8_t times) {
+// The list is in mem, each blink builds the new list in the other arena and
+// gives back the whole old one at once
+static uint64_t blink(arena mem[2], stone **head, uint8_t times) {
     for (uint8_t i = 0; i < times; i++) {
         stone *curr = *head; // Start with the head of the list
 
@@ -174,29 +177,71 @@ uint64_t blink(stone **head, uint8_t times) {
         
         // Process each stone in the current list
         while (curr != NULL) {
-            blinkStone(curr, &new);
+            blinkStone(&mem[1], curr, &new);
             curr = curr->next;
         }
 
-        freeStones(*head); // Free the old list
-        *head = new;       // Update the head to the new list
+        arenaReset(&mem[0]); // Give back the old list
+        *head = new;         // Update the head to the new list
         // This is done to avoid overlapping when processing the blink
+
+        // The arena of the new list is the one used next
+        arena tmp = mem[0];
+        mem[0] = mem[1];
+        mem[1] = tmp;
     }
 
     return countStones(*head); // Return the count of stones after blinks
 }
 
-// Main function to drive the program
-int main(void) {
+// The stones as they are before blinking
+typedef struct {
+    stone *head;
+    arena mem;
+} stoneList;
+
+// Reads the stones from the input
+static void *parseStones(const inputFile *in) {
+    stoneList *list = malloc(sizeof(stoneList));
+    list->mem = ARENA(1 << 12);
     // In this scenario the linked list is used like an hashmap
-    stone *head = parseFile(); // Parse the stones from the file
+    list->head = parseFile(&list->mem, in); // Parse the stones from the file
 
-    // Part 1: Perform 25 blinks and print the number of stones
-    printf("Part 1: \n\tNumber of stones after 25 blinks: %llu\n", blink(&head, 25));
-    // Part 2: Perform additional 50 blinks and print the number of stones
-    printf("Part 2: \n\tNumber of stones after 75 blinks: %llu\n", blink(&head, 50));
+    return list;
+}
 
-    freeStones(head); // Free the memory allocated for the stones
+// Blink a copy of the stones and return the number of stones
+static uint64_t blinkCopy(stoneList *list, uint8_t times) {
+    arena mem[2] = { ARENA(1 << 16), ARENA(1 << 16) };
+    stone *head = copyStones(&mem[0], list->head);
+    uint64_t count = blink(mem, &head, times);
+    arenaFree(&mem[0]); arenaFree(&mem[1]);
 
-    return 0; // Return success
+    return count;
 }
+
+// Part 1: Perform 25 blinks and return the number of stones
+static uint64_t blink25(void *puzzle) {
+    return blinkCopy(puzzle, 25);
+}
+
+// Part 2: Perform 75 blinks and return the number of stones
+static uint64_t blink75(void *puzzle) {
+    return blinkCopy(puzzle, 75);
+}
+
+// Free the stones of the puzzle
+static void freeStoneList(void *puzzle) {
+    stoneList *list = puzzle;
+    arenaFree(&list->mem); // Free the memory allocated for the stones
+    free(list);
+}
+
+const aocDay day11 = {
+    .number = 11,
+    .labels = { "Number of stones after 25 blinks", "Number of stones after 75 blinks" },
+    .parse = parseStones,
+    .part1 = blink25,
+    .part2 = blink75,
+    .release = freeStoneList,
+};
@@ -0,0 +1,184 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+
+#include "../common/day.h"
+#include "../common/thread.h"
+
+////////////////////////////////////////////////////////////////
+// Advent of Code 2024 - Benchmark                            //
+// Times the parse and both parts of every day given          //
+////////////////////////////////////////////////////////////////
+
+// Phases timed on every run
+enum phase { PARSE, PART1, PART2, PHASES };
+static const char * phaseNames[PHASES] = { "parse", "part1", "part2" };
+
+// Count every call to the allocator by wrapping the glibc one
+static uint64_t allocations = 0;
+
+#ifdef __GLIBC__
+extern void * __libc_malloc(size_t size);
+extern void * __libc_calloc(size_t n, size_t size);
+extern void * __libc_realloc(void * ptr, size_t size);
+
+void * malloc(size_t size) {
+    __atomic_add_fetch(&allocations, 1, __ATOMIC_RELAXED);
+    return __libc_malloc(size);
+}
+
+void * calloc(size_t n, size_t size) {
+    __atomic_add_fetch(&allocations, 1, __ATOMIC_RELAXED);
+    return __libc_calloc(n, size);
+}
+
+void * realloc(void * ptr, size_t size) {
+    __atomic_add_fetch(&allocations, 1, __ATOMIC_RELAXED);
+    return __libc_realloc(ptr, size);
+}
+#endif
+
+static uint64_t allocCount(void) {
+    return __atomic_load_n(&allocations, __ATOMIC_RELAXED);
+}
+
+// Returns a monotonic timestamp in nanoseconds
+static uint64_t now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static int compareTimes(const void * a, const void * b) {
+    uint64_t x = *(const uint64_t *) a, y = *(const uint64_t *) b;
+    return (x > y) - (x < y);
+}
+
+// Summary of the measures of a phase
+typedef struct {
+    uint64_t min;
+    uint64_t median;
+    uint64_t p99;
+    double allocs;
+    uint64_t answer;
+} stats;
+
+// Sorts the samples and picks the minimum, the median and the 99th percentile
+static void summarize(uint64_t * samples, int runs, stats * st) {
+    qsort(samples, runs, sizeof(uint64_t), compareTimes);
+
+    int p99 = (runs * 99 + 99) / 100 - 1;
+    st->min = samples[0];
+    st->median = samples[runs / 2];
+    st->p99 = samples[p99];
+}
+
+// Runs a day warmup + runs times and fills the stats of every phase, returns 0 on success
+static int benchDay(const aocDay * day, const char * path, int warmup, int runs, stats st[PHASES]) {
+    inputFile in;
+    if (inputOpen(&in, path)) return 1;
+
+    uint64_t * samples[PHASES];
+    uint64_t allocs[PHASES] = { 0 };
+    for (int p = 0; p < PHASES; p++) samples[p] = calloc(runs, sizeof(uint64_t));
+
+    for (int i = -warmup; i < runs; i++) {
+        uint64_t t[PHASES + 1], a[PHASES + 1];
+
+        // Time the parse and both parts separately
+        a[0] = allocCount(); t[0] = now();
+        void * puzzle = day->parse(&in);
+        a[1] = allocCount(); t[1] = now();
+
+        if (puzzle == NULL) {
+            fprintf(stderr, "Error while parsing the input of day %d\n", day->number);
+            for (int p = 0; p < PHASES; p++) free(samples[p]);
+            inputClose(&in);
+            return 1;
+        }
+
+        st[PART1].answer = day->part1(puzzle);
+        a[2] = allocCount(); t[2] = now();
+        st[PART2].answer = day->part2(puzzle);
+        a[3] = allocCount(); t[3] = now();
+
+        day->release(puzzle);
+
+        // Warmup runs aren't measured
+        if (i < 0) continue;
+
+        for (int p = 0; p < PHASES; p++) {
+            samples[p][i] = t[p + 1] - t[p];
+            allocs[p] += a[p + 1] - a[p];
+        }
+    }
+
+    st[PARSE].answer = 0;
+    for (int p = 0; p < PHASES; p++) {
+        summarize(samples[p], runs, &st[p]);
+        st[p].allocs = (double) allocs[p] / runs;
+        free(samples[p]);
+    }
+
+    inputClose(&in);
+    return 0;
+}
+
+static void usage(const char * name) {
+    fprintf(stderr, "Usage: %s [-n runs] [-w warmup] [-t threads] [-f csv|json] DAY:PATH...\n", name);
+    exit(1);
+}
+
+int main(int argc, char ** argv) {
+    int runs = 10, warmup = 2, json = 0;
+
+    // Read the options before the list of days
+    int arg = 1;
+    for (; arg < argc && argv[arg][0] == '-'; arg++) {
+        if (arg + 1 >= argc) usage(argv[0]);
+
+        if (strcmp(argv[arg], "-n") == 0) runs = atoi(argv[++arg]);
+        else if (strcmp(argv[arg], "-w") == 0) warmup = atoi(argv[++arg]);
+        else if (strcmp(argv[arg], "-t") == 0) setDayThreads(atoi(argv[++arg]));
+        else if (strcmp(argv[arg], "-f") == 0) json = strcmp(argv[++arg], "json") == 0;
+        else usage(argv[0]);
+    }
+
+    if (arg == argc || runs < 1 || warmup < 0) usage(argv[0]);
+
+    if (json) printf("[\n");
+    else printf("day,phase,runs,min_ns,median_ns,p99_ns,allocs,answer\n");
+
+    int first = 1, err = 0;
+    for (; arg < argc; arg++) {
+        // Every day is given as its number followed by the path of its input
+        char * path = strchr(argv[arg], ':');
+        int number = atoi(argv[arg]);
+        if (path == NULL || number < 1 || number > aocDayCount) usage(argv[0]);
+        path++;
+
+        const aocDay * day = aocDays[number - 1];
+        stats st[PHASES];
+        if (benchDay(day, path, warmup, runs, st)) { err = 1; continue; }
+
+        for (int p = 0; p < PHASES; p++) {
+            if (json) {
+                printf("%s  {\"day\": %d, \"phase\": \"%s\", \"runs\": %d, \"min_ns\": %" PRIu64
+                       ", \"median_ns\": %" PRIu64 ", \"p99_ns\": %" PRIu64 ", \"allocs\": %.1f, \"answer\": %" PRIu64 "}",
+                       first ? "" : ",\n", day->number, phaseNames[p], runs,
+                       st[p].min, st[p].median, st[p].p99, st[p].allocs, st[p].answer);
+            } else {
+                printf("%d,%s,%d,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%.1f,%" PRIu64 "\n",
+                       day->number, phaseNames[p], runs,
+                       st[p].min, st[p].median, st[p].p99, st[p].allocs, st[p].answer);
+            }
+            first = 0;
+        }
+    }
+
+    if (json) printf("\n]\n");
+
+    return err;
+}
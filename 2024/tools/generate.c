@@ -0,0 +1,332 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+////////////////////////////////////////////////////////////////
+// Advent of Code 2024 - Input generator                      //
+// Writes a valid input of the chosen size for any day        //
+////////////////////////////////////////////////////////////////
+
+// State of the pseudo random generator, the same seed always gives the same input
+static uint64_t state;
+
+// SplitMix64, small and good enough to make puzzles
+static uint64_t next(void) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Returns a random integer in [lo, hi]
+static int64_t randRange(int64_t lo, int64_t hi) {
+    return lo + (int64_t) (next() % (uint64_t) (hi - lo + 1));
+}
+
+// Returns 1 with the given probability in percent
+static int chance(int percent) {
+    return randRange(0, 99) < percent;
+}
+
+// Shuffles an array of integers
+static void shuffle(int * arr, int n) {
+    for (int i = n - 1; i > 0; i--) {
+        int j = randRange(0, i);
+        int tmp = arr[i]; arr[i] = arr[j]; arr[j] = tmp;
+    }
+}
+
+// Day 1: size lines with two location IDs, the right list reuses IDs of the left one
+static void day01(int64_t size) {
+    int * left = malloc(size * sizeof(int));
+
+    for (int64_t i = 0; i < size; i++) {
+        left[i] = randRange(10000, 99999);
+
+        // Around a third of the right IDs appear in the left list to give a similarity score
+        int right = chance(33) ? left[randRange(0, i)] : randRange(10000, 99999);
+        printf("%d   %d\n", left[i], right);
+    }
+
+    free(left);
+}
+
+// Day 2: size reports of levels, most of them safe or one level away from being safe
+static void day02(int64_t size) {
+    for (int64_t i = 0; i < size; i++) {
+        int n = randRange(5, 8);
+        int dir = chance(50) ? 1 : -1;
+        int level = dir > 0 ? randRange(1, 60) : randRange(40, 99);
+        int bad = chance(40) ? randRange(0, n - 1) : -1;
+
+        for (int j = 0; j < n; j++) {
+            // Either a valid step or, once per report, a random jump
+            int out = j == bad ? randRange(1, 99) : level;
+            printf(j == 0 ? "%d" : " %d", out);
+            level += dir * randRange(1, 3);
+        }
+
+        printf("\n");
+    }
+}
+
+// Day 3: size bytes of corrupted memory with valid and broken instructions
+static void day03(int64_t size) {
+    static const char noise[] = "!@#$%^&*()[]{}<>?/\\|+-'~ ,;:whatselectfromwhyhowmuldon'tdo";
+    char buffer[32];
+    int64_t written = 0, line = 0;
+
+    while (written < size) {
+        int len;
+        int kind = randRange(0, 99);
+
+        if (kind < 8) len = sprintf(buffer, "mul(%d,%d)", (int) randRange(0, 999), (int) randRange(0, 999));
+        else if (kind < 10) len = sprintf(buffer, "do()");
+        else if (kind < 12) len = sprintf(buffer, "don't()");
+        else if (kind < 14) len = sprintf(buffer, "mul(%d,%d]", (int) randRange(0, 999), (int) randRange(0, 999));
+        else if (kind < 15) len = sprintf(buffer, "mul ( %d , %d )", (int) randRange(0, 99), (int) randRange(0, 99));
+        else if (kind < 16) len = sprintf(buffer, "mul(%d,%d)", (int) randRange(1000, 9999), (int) randRange(0, 999));
+        else {
+            buffer[0] = noise[randRange(0, sizeof(noise) - 2)];
+            len = 1;
+        }
+
+        fwrite(buffer, 1, len, stdout);
+        written += len;
+        line += len;
+
+        // Break the dump in lines of a few thousands bytes like the real input
+        if (line > 3000) {
+            putchar('\n');
+            written++;
+            line = 0;
+        }
+    }
+
+    putchar('\n');
+}
+
+// Day 4: a size x size grid of the letters of XMAS
+static void day04(int64_t size) {
+    static const char letters[] = "XMAS";
+
+    for (int64_t r = 0; r < size; r++) {
+        for (int64_t c = 0; c < size; c++) putchar(letters[next() & 3]);
+        putchar('\n');
+    }
+}
+
+// Day 5: ordering rules for every pair of 49 pages and size updates
+static void day05(int64_t size) {
+    // The position of a page in the shuffled list is its place in the order
+    int pages[89];
+    for (int i = 0; i < 89; i++) pages[i] = i + 11;
+    shuffle(pages, 89);
+
+    int n = 49;
+    int * order = malloc(n * n * 2 * sizeof(int));
+    int nRules = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            order[nRules * 2] = pages[i];
+            order[nRules * 2 + 1] = pages[j];
+            nRules++;
+        }
+    }
+
+    // Print the rules in random order
+    int * idx = malloc(nRules * sizeof(int));
+    for (int i = 0; i < nRules; i++) idx[i] = i;
+    shuffle(idx, nRules);
+    for (int i = 0; i < nRules; i++) printf("%d|%d\n", order[idx[i] * 2], order[idx[i] * 2 + 1]);
+    printf("\n");
+
+    int update[49];
+    for (int64_t u = 0; u < size; u++) {
+        // Pick an odd number of distinct pages
+        int len = randRange(2, 11) * 2 + 1;
+        int pos[49];
+        for (int i = 0; i < n; i++) pos[i] = i;
+        shuffle(pos, n);
+
+        // Around half of the updates are already in order
+        if (chance(50)) {
+            for (int i = 1; i < len; i++) {
+                for (int j = i; j > 0 && pos[j - 1] > pos[j]; j--) {
+                    int tmp = pos[j]; pos[j] = pos[j - 1]; pos[j - 1] = tmp;
+                }
+            }
+        }
+
+        for (int i = 0; i < len; i++) update[i] = pages[pos[i]];
+        for (int i = 0; i < len; i++) printf(i == 0 ? "%d" : ",%d", update[i]);
+        printf("\n");
+    }
+
+    free(order);
+    free(idx);
+}
+
+// Returns 1 if the guard walks out of the map instead of looping
+static int guardLeaves(const char * map, int64_t size, int64_t x, int64_t y) {
+    static const int dirs[4][2] = { { -1, 0 }, { 0, 1 }, { 1, 0 }, { 0, -1 } };
+    uint8_t * seen = calloc(size * size, 1);
+    int dir = 0, leaves = 0;
+
+    while (!(seen[x * size + y] & (1 << dir))) {
+        seen[x * size + y] |= 1 << dir;
+
+        int64_t nx = x + dirs[dir][0], ny = y + dirs[dir][1];
+        if (nx < 0 || nx >= size || ny < 0 || ny >= size) { leaves = 1; break; }
+
+        if (map[nx * size + ny] == '#') dir = (dir + 1) % 4;
+        else { x = nx; y = ny; }
+    }
+
+    free(seen);
+    return leaves;
+}
+
+// Day 6: a size x size lab with a guard that eventually walks out of it
+static void day06(int64_t size) {
+    char * map = malloc(size * size);
+    int64_t x, y;
+
+    // Draw maps till the guard doesn't get stuck in a loop
+    do {
+        for (int64_t i = 0; i < size * size; i++) map[i] = chance(2) ? '#' : '.';
+
+        do {
+            x = randRange(0, size - 1);
+            y = randRange(0, size - 1);
+        } while (map[x * size + y] == '#');
+    } while (!guardLeaves(map, size, x, y));
+
+    map[x * size + y] = '^';
+
+    for (int64_t r = 0; r < size; r++) {
+        fwrite(map + r * size, 1, size, stdout);
+        putchar('\n');
+    }
+
+    free(map);
+}
+
+// Day 7: size equations, some solvable with two operators, some with three, some not at all
+static void day07(int64_t size) {
+    for (int64_t i = 0; i < size; i++) {
+        int nums[12], n;
+        uint64_t total;
+        int ops = randRange(0, 2);
+
+        // Retry with fewer numbers when the result doesn't fit in 64 bits
+        do {
+            n = randRange(2, 12);
+            for (int j = 0; j < n; j++) nums[j] = randRange(1, 999);
+
+            total = nums[0];
+            for (int j = 1; j < n && total < UINT64_MAX / 1000000; j++) {
+                int op = ops == 0 ? 3 : randRange(0, ops);
+                if (op == 0) total += nums[j];
+                else if (op == 1) total *= nums[j];
+                else if (op == 2) {
+                    for (int k = nums[j]; k > 0; k /= 10) total *= 10;
+                    total += nums[j];
+                } else total = total * randRange(1, 9) + nums[j];
+            }
+        } while (total >= UINT64_MAX / 1000000);
+
+        printf("%llu:", (unsigned long long) total);
+        for (int j = 0; j < n; j++) printf(" %d", nums[j]);
+        printf("\n");
+    }
+}
+
+// Day 8: a size x size city with antennae for each of the 62 frequencies, more as the city grows
+static void day08(int64_t size) {
+    static const char freqs[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+    char * map = malloc(size * size);
+    memset(map, '.', size * size);
+
+    // Up to one antenna of every frequency for each 10 rows, every pair of the same
+    // frequency is checked so the work grows with the square of the count
+    for (int f = 0; f < 62; f++) {
+        int64_t count = randRange(2, 2 + size / 10);
+        for (int64_t i = 0; i < count; i++) map[randRange(0, size * size - 1)] = freqs[f];
+    }
+
+    for (int64_t r = 0; r < size; r++) {
+        fwrite(map + r * size, 1, size, stdout);
+        putchar('\n');
+    }
+
+    free(map);
+}
+
+// Day 9: a disk map of size digits, alternating files and free space
+static void day09(int64_t size) {
+    // The map always ends with a file
+    if (size % 2 == 0) size++;
+
+    for (int64_t i = 0; i < size; i++) putchar('0' + (i % 2 == 0 ? randRange(1, 9) : randRange(0, 9)));
+    putchar('\n');
+}
+
+// Day 10: a size x size topographic map made of ramps going up and down so there are many trails
+static void day10(int64_t size) {
+    for (int64_t r = 0; r < size; r++) {
+        for (int64_t c = 0; c < size; c++) {
+            // A triangle wave along the diagonals, broken by random heights
+            int t = (r + c + (r / 17) * 3) % 18;
+            int h = t <= 9 ? t : 18 - t;
+            if (chance(8)) h = randRange(0, 9);
+
+            putchar('0' + h);
+        }
+        putchar('\n');
+    }
+}
+
+// Day 11: a line of size stones engraved with numbers of up to 7 digits
+static void day11(int64_t size) {
+    for (int64_t i = 0; i < size; i++) {
+        int digits = randRange(1, 7);
+        int64_t val = randRange(0, 9);
+        for (int d = 1; d < digits; d++) val = val * 10 + randRange(0, 9);
+
+        printf(i == 0 ? "%lld" : " %lld", (long long) val);
+    }
+    printf("\n");
+}
+
+static void (* const generators[])(int64_t) = {
+    day01, day02, day03, day04, day05, day06, day07, day08, day09, day10, day11,
+};
+
+int main(int argc, char ** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s DAY SIZE [SEED]\n", argv[0]);
+        fprintf(stderr, "Writes the input to stdout. SIZE is the number of lines for days 1, 2, 5 and 7,\n");
+        fprintf(stderr, "the side of the grid for days 4, 6, 8 and 10, the number of bytes for day 3,\n");
+        fprintf(stderr, "the length of the disk map for day 9 and the number of stones for day 11\n");
+        return 1;
+    }
+
+    int day = atoi(argv[1]);
+    int64_t size = atoll(argv[2]);
+    state = argc > 3 ? strtoull(argv[3], NULL, 10) : 2024;
+
+    if (day < 1 || day > 11 || size < 1) {
+        fprintf(stderr, "Unknown day or invalid size\n");
+        return 1;
+    }
+
+    // Write the input in big blocks
+    static char buffer[1 << 20];
+    setvbuf(stdout, buffer, _IOFBF, sizeof(buffer));
+
+    generators[day - 1](size);
+
+    return 0;
+}
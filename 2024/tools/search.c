@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "../common/grid.h"
+#include "../common/search.h"
+#include "../common/thread.h"
+
+////////////////////////////////////////////////////////////////
+// Advent of Code 2024 - Word search                          //
+// Counts words and shapes over a grid of letters             //
+////////////////////////////////////////////////////////////////
+
+// Most rows a shape can have
+#define SHAPE_ROWS 64
+
+// Band of rows counted by a thread and the counts of every pattern
+typedef struct {
+    const searchDict * d;
+    const grid * g;
+    int r0;
+    int r1;
+    uint64_t * counts;
+} searchBand;
+
+// Counts the patterns starting in a band
+static void countBand(int i, void * arg) {
+    searchBand * band = (searchBand *) arg + i;
+    searchCount(band->d, band->g, band->r0, band->r1, band->counts);
+}
+
+// Splits the rows of a shape given as ROW/ROW/..., returns the number of rows
+static int splitShape(char * pattern, char * rows[SHAPE_ROWS]) {
+    int n = 0;
+    for (char * row = strtok(pattern, "/"); row != NULL && n < SHAPE_ROWS; row = strtok(NULL, "/")) rows[n++] = row;
+
+    return n;
+}
+
+// Counts a word the plain way, trying every cell and every direction
+static uint64_t plainWord(const grid * g, const char * word) {
+    const int dr[8] = { -1, -1, -1, 0, 0, 1, 1, 1 }, dc[8] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+    int len = strlen(word);
+    uint64_t count = 0;
+
+    for (int r = 0; r < g->rows; r++) {
+        for (int c = 0; c < g->cols; c++) {
+            for (int k = 0; k < 8; k++) {
+                int i = 0;
+                for (; i < len; i++) {
+                    int rr = r + dr[k] * i, cc = c + dc[k] * i;
+                    if (rr < 0 || rr >= g->rows || cc < 0 || cc >= g->cols) break;
+                    if (GRID_AT(*g, rr, cc) != word[i]) break;
+                }
+                count += i == len;
+            }
+        }
+    }
+
+    return count;
+}
+
+// Counts a shape the plain way, trying every top left corner
+static uint64_t plainShape(const grid * g, char * const * rows, int height) {
+    int width = strlen(rows[0]);
+    uint64_t count = 0;
+
+    for (int r = 0; r + height <= g->rows; r++) {
+        for (int c = 0; c + width <= g->cols; c++) {
+            int match = 1;
+            for (int i = 0; i < height && match; i++) {
+                for (int j = 0; j < width && match; j++) {
+                    match = rows[i][j] == SEARCH_ANY || GRID_AT(*g, r + i, c + j) == rows[i][j];
+                }
+            }
+            count += match;
+        }
+    }
+
+    return count;
+}
+
+static void usage(const char * name) {
+    fprintf(stderr, "Usage: %s [-c] [-t threads] FILE PATTERN...\n", name);
+    fprintf(stderr, "A PATTERN is a word, found in the 8 directions, or a shape given as ROW/ROW/...\n");
+    fprintf(stderr, "where %c matches any letter. -c checks every count against a plain search\n", SEARCH_ANY);
+    exit(1);
+}
+
+int main(int argc, char ** argv) {
+    int check = 0;
+
+    // Read the options before the file
+    int arg = 1;
+    for (; arg < argc && argv[arg][0] == '-'; arg++) {
+        if (strcmp(argv[arg], "-c") == 0) check = 1;
+        else if (strcmp(argv[arg], "-t") == 0 && arg + 1 < argc) setDayThreads(atoi(argv[++arg]));
+        else usage(argv[0]);
+    }
+
+    if (argc - arg < 2) usage(argv[0]);
+
+    inputFile in;
+    grid g;
+    if (inputOpen(&in, argv[arg])) return 1;
+    if (gridFromInput(&g, &in, 0, '.')) {
+        fprintf(stderr, "Error while reading the grid of %s\n", argv[arg]);
+        inputClose(&in);
+        return 1;
+    }
+    inputClose(&in);
+    arg++;
+
+    // Add every pattern, the shapes are told apart by their rows
+    int n = argc - arg;
+    char ** names = &argv[arg];
+    searchDict d;
+    searchInit(&d);
+
+    for (int i = 0; i < n; i++) {
+        char * pattern = strdup(names[i]), * rows[SHAPE_ROWS];
+        int id = strchr(pattern, '/') || strchr(pattern, SEARCH_ANY)
+            ? searchAddShape(&d, (const char * const *) rows, splitShape(pattern, rows))
+            : searchAddWord(&d, pattern);
+        free(pattern);
+
+        if (id != i) {
+            fprintf(stderr, "Invalid pattern %s\n", names[i]);
+            searchFree(&d); gridFree(&g);
+            return 1;
+        }
+    }
+    searchBuild(&d);
+
+    // Count the bands of rows in parallel, each band has its own counts
+    int parts = dayThreads();
+    if (parts > g.rows) parts = g.rows;
+    if (parts < 1) parts = 1;
+
+    searchBand * bands = calloc(parts, sizeof(searchBand));
+    uint64_t * counts = calloc((size_t) parts * n, sizeof(uint64_t));
+    for (int i = 0; i < parts; i++) {
+        bands[i] = (searchBand) {
+            .d = &d, .g = &g,
+            .r0 = (int) ((int64_t) g.rows * i / parts), .r1 = (int) ((int64_t) g.rows * (i + 1) / parts),
+            .counts = counts + (size_t) i * n,
+        };
+    }
+
+    parallelFor(parts, parts, countBand, bands);
+
+    int err = 0;
+    for (int i = 0; i < n; i++) {
+        uint64_t total = 0;
+        for (int b = 0; b < parts; b++) total += counts[(size_t) b * n + i];
+        printf("%s: %" PRIu64 "\n", names[i], total);
+
+        if (!check) continue;
+
+        // Search the pattern again on its own
+        char * pattern = strdup(names[i]), * rows[SHAPE_ROWS];
+        uint64_t plain = strchr(pattern, '/') || strchr(pattern, SEARCH_ANY)
+            ? plainShape(&g, rows, splitShape(pattern, rows))
+            : plainWord(&g, pattern);
+        free(pattern);
+
+        if (plain != total) {
+            fprintf(stderr, "Error: %s is found %" PRIu64 " times by a plain search\n", names[i], plain);
+            err = 1;
+        }
+    }
+
+    free(bands); free(counts);
+    searchFree(&d); gridFree(&g);
+    return err;
+}